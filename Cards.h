@@ -15,6 +15,8 @@
 
 #include <stdio.h>               // Required for input and output
 #include <stdlib.h>              // Required for rand() and exit()
+#include <wchar.h>               // Required for wprintf()
+#include <pthread.h>             // Required for the audit locks
 
     /* Constants Declaration */
 
@@ -29,6 +31,7 @@
 #define VALID_ARGUMENTS_AMOUNT 3 // Expected valid argument amount
 #define MIN_ARGV_LEN 1           // Minimum string length for a valid argument
 #define MAX_ARG_LEN 2            // Maximum string length for a valid argument
+#define MAX_COUNT_ARGUMENT 100000000 // Maximum value for count arguments
 #define MIN_INPUT_RANGE 1        // Minimum numeric value for valid input
 #define MAX_INPUT_RANGE 13       // Maximum numeric value for valid input
 
@@ -46,6 +49,7 @@
 #define DEFAULT -1               // Parameter to display hands
 #define WITH_RANK -2             // Parameter to display hands with rank
 #define TESTING -3               // Parameter to display testing hands
+#define WITH_WINNERS -4          // Parameter to display best valued hands
 
 #define TRUE 1                   // True for boolean functions
 #define FALSE 0                  // False for boolean functions
@@ -54,17 +58,133 @@
 #define INVALID_INPUT -1         // For unsuccesful validation
 
 #define NO_ERRORS 0              // Exit successful
+#define VERIFY_FAILED 1          // Exit when an evaluator mismatch was found
+#define AUDIT_FAILED 2           // Exit when a recorded winner was wrong
+
+#define MODE_INDEX 1             // Program mode argument index for argv
+#define MODE_VERIFY "verify"     // Mode to verify fast evaluators
+#define VERIFY_SAMPLES_INDEX 2   // Sample amount argument index for verify
+#define VERIFY_DEFAULT_SAMPLES 200000 // Random hands checked per hand size
+
+#define RANK_MASK_AMOUNT 8192    // Amount of 13 bit rank masks (2^13)
+#define HAND_VALUE_SHIFT 20      // Bit position of the poker rank in a value
+#define KICKER_BITS 4            // Bits used by each rank in a hand value
+#define MAX_EVAL_CARDS 7         // Largest hand size for the fast evaluator
+#define MAX_MESSAGE_LEN 64       // Size of formatted display messages
+#define MAX_VERIFY_CARDS 10      // Largest amount of cards in a verified deal
+
+#define BOARD_SIZE 5             // Community cards on a complete board
+#define FLOP_SIZE 3              // Community cards on the flop
+#define OMAHA_HOLE_SIZE 4        // Hole cards per player in Omaha
+#define PLO5_HOLE_SIZE 5         // Hole cards per player in 5 card Omaha
+#define OMAHA_HOLE_USED 2        // Hole cards that must be used in Omaha
+#define OMAHA_BOARD_USED 3       // Board cards that must be used in Omaha
+#define MAX_HOLE_PAIRS 10        // Two card combinations of PLO5_HOLE_SIZE
+#define MAX_BOARD_TRIPLES 10     // Three card combinations of BOARD_SIZE
+#define NO_SUIT -1               // Cards of a group do not share a suit
+
+#define LOW_VALUE_LIMIT 0x1000000 // Above every hand value, to invert them
+#define NO_LOW 0                 // Low value of a hand that does not qualify
+#define LOW_QUALIFIER_MASK 0xFF  // Ranks ACE to EIGHT, for 8 or better
+
+#define MODE_FLOPS "flops"       // Mode to enumerate flops by suit isomorphism
+#define FLOPS_HOLE_INDEX 2       // Hole cards argument index for flops
+#define CARD_TEXT_LEN 2          // Characters of a card as text, such as As
+#define SUIT_RANKS_MASK 0x1FFF   // The 13 rank bits of one suit in a mask
+#define ISO_MAX_GROUPS 4         // Card groups of a canonical suit key
+#define HOLDEM_HOLE_SIZE 2       // Hole cards per player in Hold'em
+#define MAX_PLAYERS 10           // Most players in a community card deal
+#define FULL_DECK_MASK 0xFFFFFFFFFFFFFULL // Card mask with all DECK_SIZE bits
+#define HASH_MULTIPLIER 0x9E3779B97F4A7C15ULL // Fibonacci hashing constant
+
+#define MODE_OMAHA "omaha"       // Mode to deal and rank an Omaha showdown
+#define OMAHA_HOLE_INDEX 2       // Hole card amount argument index for omaha
+#define OMAHA_PLAYERS_INDEX 3    // Player amount argument index for omaha
+#define OMAHA_POT_INDEX 4        // Hi-lo pot argument index for omaha
+
+#define MODE_OUTS "outs"         // Mode to calculate outs of every player
+#define OUTS_BOARD_INDEX 2       // Board argument index for outs
+#define OUTS_FIRST_HOLE_INDEX 3  // First hole cards argument index for outs
+
+#define MODE_DEAL "deal"         // Mode to deal hands of a deck variant
+#define DEAL_VARIANT_INDEX 2     // Deck variant argument index for deal
+#define DEAL_PLAYERS_INDEX 3     // Player amount argument index for deal
+#define DEAL_RANKS_INDEX 4       // Custom rank list argument index for deal
+#define ALL_RANKS 0x1FFF         // Every Rank, one bit per Rank
+#define SHORT_DECK_RANKS 0x1FE1  // ACE and SIX to KING, one bit per Rank
+#define MAX_JOKERS 2             // Most jokers added to a deck variant
+#define MAX_DECK_SIZE 54         // DECK_SIZE plus MAX_JOKERS
+#define MAX_STRAIGHT_WILDS 4     // Most wild cards short of five of a kind
+#define DEUCES_WILD_RANKS 0x2    // TWO, one bit per Rank
+
+#define MODE_EQUITY "equity"     // Mode to sample equity until precise enough
+#define EQUITY_WIDTH_INDEX 2     // Interval width argument index for equity
+#define EQUITY_SECONDS_INDEX 3   // Time budget argument index for equity
+#define EQUITY_BOARD_INDEX 4     // Board argument index for equity
+#define EQUITY_FIRST_HOLE_INDEX 5 // First hole cards argument index
+#define EMPTY_BOARD "-"          // Board argument before the flop
+#define EQUITY_BATCH_DEALS 1000  // Deals between two stopping checks
+#define EQUITY_Z_SCORE 1.96      // Normal quantile of a 95% interval
+
+#define MODE_JOB "job"           // Mode to run one shard of an enumeration
+#define MODE_MERGE "merge"       // Mode to merge the result files of shards
+#define JOB_SHARD_INDEX 2        // Shard number argument index for job
+#define JOB_SHARDS_INDEX 3       // Shard amount argument index for job
+#define JOB_FILE_INDEX 4         // Result file argument index for job
+#define JOB_BOARD_INDEX 5        // Board argument index for job
+#define JOB_FIRST_HOLE_INDEX 6   // First hole cards argument index for job
+#define MERGE_OUTPUT_INDEX 2     // Output file argument index for merge
+#define MERGE_FIRST_INPUT_INDEX 3 // First input file argument index
+#define MAX_SHARDS 64            // Most shards of a job, one bit each
+#define JOB_MAGIC 0x33424F4A     // First bytes of a result file, "JOB3"
+#define JOB_POT_UNITS 2520       // Pot units, split evenly by 1 to 10 ties
+#define JOB_CHECKPOINT_DEALS 1000000 // Deals between two saved checkpoints
+#define JOB_PATH_LEN 1024        // Size of the temporary file path
+
+#define EVAL_CACHE_PROBES 4      // Slots probed before replacing an entry
+#define EVAL_CACHE_SLOTS 65536   // Default slots of an evaluation cache
+
+#define MODE_PUSHFOLD "pushfold" // Mode to solve heads-up push or fold
+#define PUSHFOLD_STACK_INDEX 2   // Largest stack argument index for pushfold
+#define PUSHFOLD_SAMPLES_INDEX 3 // Samples argument index for pushfold
+#define HAND_CLASSES 169         // Starting hands up to suit isomorphism
+#define MAX_CLASS_COMBOS 12      // Card combinations of an offsuit class
+#define HOLE_COMBOS 1326         // Two card combinations of a deck
+#define PUSHFOLD_SAMPLES 2000    // Default boards per pair of classes
+#define PUSHFOLD_ITERATIONS 20000 // Fictitious play rounds per stack
+#define PUSHFOLD_STACK_STEP 0.5  // Big blinds between swept stacks
+#define MAX_STACKS 200           // Most stacks in a sweep
+#define MAX_THREADS 64           // Most worker threads
+#define PUSHFOLD_SEED 0x853C49E6748FEA9BULL // Seed of the equity samples
+
+#define MODE_AUDIT "audit"       // Mode to audit a hand history log
+#define AUDIT_FILE_INDEX 2       // Hand history argument index for audit
+#define AUDIT_THREADS_INDEX 3    // Threads argument index for audit
+#define AUDIT_CACHE_INDEX 4      // Cache option argument index for audit
+#define AUDIT_CACHE_OPTION "cache" // Option to audit through caches
+#define AUDIT_CHUNK_BYTES 1048576 // Bytes of records per work chunk
+#define AUDIT_WINDOW_CHUNKS 4    // Chunks audited ahead of output per thread
+#define AUDIT_ECHO_LEN 80        // Most bytes echoed of a record
+#define AUDIT_ESCAPED_LEN 321    // Echoed bytes escaped as \xNN, and NUL
+#define FIELD_SEPARATOR ';'      // Separates the fields of a record
+#define SEAT_SEPARATOR ' '       // Separates the hole cards of the seats
+#define WINNER_SEPARATOR ','     // Separates the winning seats
+#define COMMENT_MARK '#'         // Starts a line that is not a record
 
     /* Enum & Struct Definitions */
 
-typedef enum suit {HEART, DIAMOND, CLUBS, SPADES} Suit;
+typedef unsigned long long CardMask;   // One bit per card, see getCardMask()
+typedef unsigned int HandValue;        // Comparable strength of a hand
+
+typedef enum suit {HEART, DIAMOND, CLUBS, SPADES, JOKER} Suit; // JOKER: wild
 
 typedef enum rank {ACE, TWO, THREE, FOUR, FIVE, SIX, SEVEN, EIGHT, NINE, TEN,
                    JACK, QUEEN, KING} Rank;
 
 typedef enum pokerRank {HIGH_CARD, ONE_PAIR, TWO_PAIRS,
                         THREE_OF_A_KIND, STRAIGHT, FLUSH, FULL_HOUSE,
-                        FOUR_OF_A_KIND, STRAIGHT_FLUSH} PokerRank;
+                        FOUR_OF_A_KIND, STRAIGHT_FLUSH,
+                        FIVE_OF_A_KIND} PokerRank;
 
 enum handIndex {FIRST_CARD, SECOND_CARD, THIRD_CARD, FOURTH_CARD, FIFTH_CARD};
 
@@ -76,8 +196,166 @@ typedef struct card {
 typedef struct hand {
     Card cards[POKER_HAND_SIZE];
     PokerRank handRank;
+    HandValue handValue;
 } Hand;
 
+typedef HandValue (*ValueEvaluator)(const Card cards[], int cardAmount);
+
+typedef struct verifyResult {
+    long checked;                      // Amount of hands compared
+    int mismatch;                      // TRUE if a mismatch was found
+    int cardAmount;                    // Size of the mismatching deal
+    Card cards[MAX_VERIFY_CARDS];      // First mismatching deal
+    PokerRank expected;                // Rank given by the reference
+    PokerRank found;                   // Rank given by the evaluator
+    HandValue expectedValue;           // Value given by the reference
+    HandValue foundValue;              // Value given by the evaluator
+} VerifyResult;
+
+typedef struct omahaPart {
+    CardMask mask;                     // Cards of the part
+    unsigned int counts[CARD_TYPE_AMOUNT]; // counts[n]: ranks seen > n times
+    int suit;                          // Suit of all the cards, or NO_SUIT
+} OmahaPart;
+
+typedef struct omahaBoard {
+    int tripleAmount;                  // Three card combinations of board
+    OmahaPart triples[MAX_BOARD_TRIPLES];
+    int patternAmount;                 // Triples with distinct rank counts
+    OmahaPart patterns[MAX_BOARD_TRIPLES];
+    int flushSuits;                    // Bit set for each monotone triple suit
+    HandValue pairValues[CARD_NUMBERS_AMOUNT][CARD_NUMBERS_AMOUNT]; // Memo
+} OmahaBoard;
+
+typedef struct streetState {
+    unsigned int suitRanks[CARD_TYPE_AMOUNT]; // Rank mask of each suit
+    unsigned int rankCounts[CARD_TYPE_AMOUNT]; // [n]: ranks held n+1 times
+    unsigned int flushRanks;           // Ranks of a 5+ card suit, else 0
+    CardMask cards;                    // Every card absorbed so far
+    int cardAmount;                    // Amount of cards absorbed
+} StreetState;
+
+typedef struct outsResult {
+    CardMask winningOuts;              // Next cards making a losing player best
+    CardMask improvingOuts;            // Next cards raising its PokerRank
+                                       // above the one of the board alone
+    double turnProbability;            // Chance of being best next card
+    double riverProbability;           // Chance of being best on the river
+} OutsResult;
+
+typedef struct equityResult {
+    double equity[MAX_PLAYERS];        // Mean share of the pot won
+    double errorBound[MAX_PLAYERS];    // Half width of the 95% interval
+    long deals;                        // Amount of deals sampled
+    double seconds;                    // Processor time spent sampling
+} EquityResult;
+
+typedef struct jobResult {
+    unsigned int magic;                // JOB_MAGIC
+    int players;                       // Amount of players
+    int boardAmount;                   // Amount of known board cards
+    int shards;                        // Shards the job is split into
+    int randomHole;                    // TRUE if the last hole is enumerated
+    CardMask holes[MAX_PLAYERS];       // Hole cards of each player
+    CardMask board;                    // Known board cards
+    unsigned long long shardMask;      // Bit set for each shard included
+    long long next;                    // Next combination index to deal
+    long long end;                     // End of the combination range
+    long long deals;                   // Deals of the classes dealt
+    long long shares[MAX_PLAYERS];     // JOB_POT_UNITS per pot won
+} JobResult;
+
+typedef struct evalCacheEntry {
+    CardMask mask;                     // Cards evaluated, 0 if empty
+    HandValue value;                   // Result of the evaluation
+} EvalCacheEntry;
+
+typedef struct evalCache {
+    EvalCacheEntry *entries;           // Open addressing slots
+    long capacity;                     // Amount of slots, a power of two
+    int shift;                         // Hash bits dropped to get a slot
+    long hits;                         // Lookups found in the cache
+    long misses;                       // Lookups evaluated and stored
+} EvalCache;
+
+typedef struct pushFoldTable {
+    CardMask combos[HAND_CLASSES][MAX_CLASS_COMBOS]; // Cards of each combo
+    int comboAmounts[HAND_CLASSES];    // Combos of each class
+    float equity[HAND_CLASSES][HAND_CLASSES]; // Row class against column
+    unsigned char weights[HAND_CLASSES][HAND_CLASSES]; // Compatible combos
+} PushFoldTable;
+
+typedef struct pushFoldResult {
+    double stack;                      // Effective stack in big blinds
+    double push[HAND_CLASSES];         // Small blind pushing frequency
+    double call[HAND_CLASSES];         // Big blind calling frequency
+    double value;                      // Small blind result in big blinds
+    double exploitability;             // Gain of the best responses
+} PushFoldResult;
+
+typedef struct solverTask {
+    PushFoldTable *table;              // Shared equity table
+    PushFoldResult *results;           // Shared stacks to solve
+    int resultAmount;                  // Amount of stacks
+    long samples;                      // Boards per pair of classes
+    int thread;                        // Index of the worker thread
+    int threads;                       // Amount of worker threads
+} SolverTask;
+
+typedef struct auditChunk {
+    const char *begin;                 // First byte of its first record
+    const char *end;                   // Byte after its last record
+    char *report;                      // Lines to output, in record order
+    long reportLength;                 // Bytes used in the report
+    long reportCapacity;               // Bytes allocated for the report
+    long records;                      // Showdowns audited
+    long mismatches;                   // Showdowns with other winners
+    long invalid;                      // Records that could not be read
+    int done;                          // TRUE once audited
+} AuditChunk;
+
+typedef struct auditJob {
+    AuditChunk *chunks;                // Chunks in file order
+    int chunkAmount;                   // Amount of chunks
+    int nextChunk;                     // Next chunk to claim
+    int written;                       // Chunks output so far
+    int window;                        // Most chunks audited ahead of output
+    EvalCache caches[MAX_THREADS];     // Evaluation cache of each thread
+    int useCache;                      // TRUE to evaluate through caches
+    pthread_mutex_t lock;              // Guards claims, done and written
+    pthread_cond_t changed;            // Signals a chunk done or written
+} AuditJob;
+
+typedef struct auditTask {
+    AuditJob *job;                     // Shared audit job
+    int thread;                        // Index of the worker thread
+} AuditTask;
+
+typedef struct deckVariant {
+    const char *name;                  // Name of the variant in arguments
+    unsigned int ranks;                // Ranks in the deck, one bit per Rank
+    int jokers;                        // Jokers added to the deck
+    ValueEvaluator evaluator;          // Evaluator following its rules
+    const PokerRank *classRanks;       // Poker rank of each value class
+} DeckVariant;
+
+typedef struct isoEntry {
+    CardMask groups[ISO_MAX_GROUPS];   // Canonical card groups
+    long weight;                       // Inputs mapped here, 0 if empty
+} IsoEntry;
+
+typedef struct suitSymmetry {
+    int order[CARD_TYPE_AMOUNT];       // Suits sorted by fixed signature
+    int interchangeable[CARD_TYPE_AMOUNT]; // TRUE if as the previous suit
+} SuitSymmetry;
+
+typedef struct isoTable {
+    IsoEntry *entries;                 // Open addressing slots
+    long capacity;                     // Amount of slots, a power of two
+    long size;                         // Amount of used slots
+    int groupAmount;                   // Card groups per key
+} IsoTable;
+
     /* Card Display Representation */
 
 static const char CARD_NUM_SYMBOL[] = {'A', '2', '3', '4', '5', '6', '7',
@@ -86,29 +364,40 @@ static const char CARD_NUM_SYMBOL[] = {'A', '2', '3', '4', '5', '6', '7',
 static const int CARD_TYPE_SYMBOL[] = {HEART_SYMBOL, DIAMOND_SYMBOL,
                                         CLUBS_SYMBOL, SPADES_SYMBOL};
 
+static const char CARD_SUIT_LETTER[] = {'h', 'd', 'c', 's'};
+
 static const wchar_t *POKER_RANK_STRING[] = {L"High Card", L"One Pair",
                L"Two Pairs", L"Three of a Kind", L"Straight", L"Flush",
-               L"Full House", L"Four of a Kind", L"Straight Flush"};
+               L"Full House", L"Four of a Kind", L"Straight Flush",
+               L"Five of a Kind"};
+
+static const PokerRank STANDARD_CLASS_RANKS[] = {HIGH_CARD, ONE_PAIR,
+               TWO_PAIRS, THREE_OF_A_KIND, STRAIGHT, FLUSH, FULL_HOUSE,
+               FOUR_OF_A_KIND, STRAIGHT_FLUSH, FIVE_OF_A_KIND};
+
+static const PokerRank SHORT_DECK_CLASS_RANKS[] = {HIGH_CARD, ONE_PAIR,
+               TWO_PAIRS, THREE_OF_A_KIND, STRAIGHT, FULL_HOUSE, FLUSH,
+               FOUR_OF_A_KIND, STRAIGHT_FLUSH};
 
 static Hand TEST_HANDS[TEST_HANDS_SIZE] = {
     {{{TWO, DIAMOND}, {THREE, CLUBS}, {FOUR, DIAMOND}, {SIX, SPADES},
-    {QUEEN, HEART}}, 0},    // Test hand no. 1
+    {QUEEN, HEART}}, 0, 0}, // Test hand no. 1
     {{{FOUR, HEART}, {FIVE, HEART}, {FIVE, DIAMOND}, {SEVEN, HEART},
-    {TEN, SPADES}}, 0},     // Test hand no. 2
+    {TEN, SPADES}}, 0, 0},  // Test hand no. 2
     {{{THREE, DIAMOND}, {THREE, HEART}, {TEN, CLUBS}, {TEN, DIAMOND},
-    {QUEEN, CLUBS}}, 0},    // Test hand no. 3
+    {QUEEN, CLUBS}}, 0, 0}, // Test hand no. 3
     {{{THREE, DIAMOND}, {THREE, HEART}, {THREE, SPADES}, {TEN, DIAMOND},
-    {QUEEN, CLUBS}}, 0},    // Test hand no. 4
+    {QUEEN, CLUBS}}, 0, 0}, // Test hand no. 4
     {{{ACE, SPADES}, {TWO, DIAMOND}, {THREE, CLUBS}, {FOUR, DIAMOND},
-    {FIVE, DIAMOND}}, 0},   // Test hand no. 5
+    {FIVE, DIAMOND}}, 0, 0}, // Test hand no. 5
     {{{TWO, CLUBS}, {THREE, CLUBS}, {FOUR, CLUBS}, {SIX, CLUBS},
-    {QUEEN, CLUBS}}, 0},    // Test hand no. 6
+    {QUEEN, CLUBS}}, 0, 0}, // Test hand no. 6
     {{{THREE, DIAMOND}, {THREE, HEART}, {THREE, SPADES}, {TEN, DIAMOND},
-    {TEN, CLUBS}}, 0},      // Test hand no. 7
+    {TEN, CLUBS}}, 0, 0},   // Test hand no. 7
     {{{THREE, DIAMOND}, {THREE, HEART}, {THREE, SPADES}, {THREE, CLUBS},
-    {QUEEN, CLUBS}}, 0},    // Test hand no. 8
+    {QUEEN, CLUBS}}, 0, 0}, // Test hand no. 8
     {{{ACE, DIAMOND}, {TEN, DIAMOND}, {JACK, DIAMOND}, {QUEEN, DIAMOND},
-    {KING, DIAMOND}}, 0},   // Test hand no. 9
+    {KING, DIAMOND}}, 0, 0}, // Test hand no. 9
 };
 
     /* Function Prototypes */
@@ -120,19 +409,39 @@ int validateArgument(char *argument);
 int isCharValidInteger(char charToTest);
 int validateInputCombination(int cardsPerHand, int players);
 int stringToInt(char *string);
+long validateCountArgument(char *argument);
+double validateRealArgument(char *argument);
+int parseCard(const char *text, Card *card);
+int parseCards(const char *text, Card cards[], int maxCards);
+int parseRanks(const char *text, unsigned int *ranks);
 void invalidInputTerminate();
 
+// Program Modes
+int isProgramMode(char *argument);
+int runProgramMode(int argc, char *argv[]);
+
 // Process
 void initializeDeck(Card *deck);
 void shuffleDeck(Card *deck);
+void shuffleCards(Card *deck, int deckSize);
+void drawRandomCards(Card *deck, int deckSize, int amount);
 void swapCards(Card *deck, int index1, int index2);
 void drawHands(const Card deck[], Hand hands[], int players);
 void sortHands(Hand hands[], int players);
 int getComparable(Card card);
+void firstCombination(int indexes[], int chosen);
+int nextCombination(int indexes[], int chosen, int total);
+long long countCombinations(int total, int chosen);
+void unrankCombination(long long index, int indexes[], int chosen,
+                       int total);
 void rankHands(Hand hands[], int players);
 int checkHandFor(Hand hand, PokerRank rank);
 PokerRank calcPokerRank(Hand hand);
 PokerRank getWinningRank(const Hand hands[], int players);
+void valueHands(Hand hands[], int players, ValueEvaluator evaluator);
+HandValue getWinningValue(const Hand hands[], int players);
+void splitPot(const HandValue high[], const HandValue low[], int players,
+              long pot, long shares[]);
 int isFlush(const Card cards[]);
 int isStraight(const Card cards[]);
 int isStraightFlush(const Card cards[]);
@@ -142,8 +451,150 @@ int isThreeOfAKind(const Card cards[]);
 int isTwoPairs(const Card cards[]);
 int isOnePair(const Card cards[]);
 
+// Fast Evaluation
+void initializeEvaluator();
+int getHighRank(Rank rank);
+CardMask getCardMask(Card card);
+CardMask cardsToMask(const Card cards[], int cardAmount);
+HandValue evaluateSuits(const unsigned int suitRanks[]);
+HandValue evaluateMask(CardMask mask);
+HandValue evaluateCards(const Card cards[], int cardAmount);
+PokerRank getValueRank(HandValue value);
+HandValue evaluateNoFlush(const unsigned int rankMasks[]);
+Card getMaskCard(int bit);
+HandValue evaluateShortDeckSuits(const unsigned int suitRanks[]);
+HandValue evaluateWildSuits(const unsigned int suitRanks[], int wilds);
+
+// Omaha Evaluation
+void prepareOmahaBoard(const Card board[], int boardAmount,
+                       OmahaBoard *prepared);
+HandValue evaluateOmaha(const Card hole[], int holeAmount,
+                        OmahaBoard *prepared);
+HandValue evaluateOmahaNaive(const Card hole[], int holeAmount,
+                             const Card board[], int boardAmount);
+void evaluateOmahaPlayers(const Card holes[], int holeAmount, int players,
+                          const Card board[], int boardAmount,
+                          HandValue values[]);
+void displayOmahaPlayers(const Card holes[], int holeAmount, int players,
+                         const Card board[], const HandValue values[],
+                         const HandValue lows[], const long shares[]);
+
+// Low Evaluation
+void initializeLowTables();
+HandValue evaluateAceToFive(const Card cards[], int cardAmount);
+HandValue evaluateEightOrBetter(const Card cards[], int cardAmount);
+HandValue evaluateDeuceToSeven(const Card cards[], int cardAmount);
+HandValue evaluateOmahaLow(const Card hole[], int holeAmount,
+                           const Card board[], int boardAmount);
+
+// Suit Isomorphism
+void canonicalizeGroups(const CardMask groups[], int groupAmount,
+                        CardMask canonical[], int permutation[]);
+CardMask permuteSuits(CardMask mask, const int permutation[]);
+int createIsoTable(IsoTable *table, long expectedKeys, int groupAmount);
+long addIsoKey(IsoTable *table, const CardMask canonical[], long weight);
+long findIsoKey(const IsoTable *table, const CardMask canonical[]);
+void freeIsoTable(IsoTable *table);
+void initializeSymmetry(SuitSymmetry *symmetry, const CardMask fixed[],
+                        int fixedAmount);
+long calcClassWeight(const SuitSymmetry *symmetry, CardMask board);
+int enumerateCanonicalBoards(const CardMask fixed[], int fixedAmount,
+                             int boardAmount, IsoTable *table);
+long calcFlopRanks(CardMask hole, double distribution[]);
+
+// Street By Street Evaluation
+void initializeStreetState(StreetState *state);
+void addStreetBit(StreetState *state, int bit);
+void addStreetCard(StreetState *state, Card card);
+void addStreetCards(StreetState *state, const Card cards[], int cardAmount);
+HandValue evaluateStreetState(const StreetState *state);
+HandValue evaluateStreetCards(const Card cards[], int cardAmount);
+
+// Outs
+int calcOuts(const Card holes[], int players, const Card board[],
+             int boardAmount, OutsResult results[]);
+void displayOuts(const OutsResult results[], int players);
+
+// Equity
+int calcAdaptiveEquity(const Card holes[], int players, const Card board[],
+                       int boardAmount, double width, double seconds,
+                       EquityResult *result);
+void displayEquity(const EquityResult *result, int players);
+
+// Enumeration Jobs
+int initializeJob(JobResult *job, const Card holes[], int players,
+                  int randomHole, const Card board[], int boardAmount,
+                  int shard, int shards);
+int loadJob(const char *path, JobResult *job);
+int saveJob(const char *path, const JobResult *job);
+int isSameJob(const JobResult *job, const JobResult *other);
+int runJobShard(const char *path, JobResult *job);
+int mergeJobs(JobResult *merged, const JobResult *part);
+void displayJob(const JobResult *job);
+
+// Evaluation Cache
+int createEvalCache(EvalCache *cache, long capacity);
+void freeEvalCache(EvalCache *cache);
+int lookupEvalCache(EvalCache *cache, CardMask mask, HandValue *value);
+void storeEvalCache(EvalCache *cache, CardMask mask, HandValue value);
+HandValue evaluateMaskCached(EvalCache *cache, CardMask mask);
+void displayEvalCache(const EvalCache *cache, wchar_t *message);
+
+// Push Or Fold Solver
+int getHandClass(CardMask hole);
+int getThreadAmount();
+void createPushFoldTable(PushFoldTable *table, long samples, int threads);
+void solvePushFold(const PushFoldTable *table, PushFoldResult *result);
+void solvePushFoldSweep(const PushFoldTable *table, PushFoldResult results[],
+                        int resultAmount, int threads);
+void displayPushFoldSweep(const PushFoldTable *table,
+                          const PushFoldResult results[], int resultAmount);
+
+// Hand History Audit
+int splitAuditChunks(AuditJob *job, const char *data, long size);
+void auditRecord(AuditChunk *chunk, EvalCache *cache, const char *line,
+                 const char *end);
+int runAudit(const char *data, long size, int threads, AuditChunk *totals,
+             EvalCache *cacheTotals);
+long auditFile(const char *path, int threads, AuditChunk *totals,
+               EvalCache *cacheTotals);
+void displayAudit(const AuditChunk *totals, const EvalCache *cacheTotals,
+                  long size, double seconds);
+
+// Deck Variants
+const DeckVariant *findDeckVariant(const char *name);
+int getVariantDeckSize(const DeckVariant *variant);
+int initializeVariantDeck(Card deck[], const DeckVariant *variant);
+HandValue evaluateShortDeckCards(const Card cards[], int cardAmount);
+HandValue evaluateWildCards(const Card cards[], int cardAmount,
+                            unsigned int wildRanks);
+HandValue evaluateJokerCards(const Card cards[], int cardAmount);
+HandValue evaluateDeucesWildCards(const Card cards[], int cardAmount);
+PokerRank getVariantRank(HandValue value, const DeckVariant *variant);
+void rankVariantHands(Hand hands[], int players, const DeckVariant *variant);
+
+// Verification
+PokerRank calcReferenceRank(const Card cards[], int cardAmount);
+HandValue calcReferenceValue(const Card cards[], int cardAmount);
+void verifyExhaustive(ValueEvaluator evaluator, VerifyResult *result);
+void verifySampled(ValueEvaluator evaluator, int cardAmount, long samples,
+                   VerifyResult *result);
+int verifyEvaluator(ValueEvaluator evaluator, wchar_t *name, long samples);
+void verifyOmaha(int holeAmount, long samples, VerifyResult *result);
+void verifyIsomorphism(long samples, VerifyResult *result);
+void verifyCanonicalBoards(VerifyResult *result);
+void verifyEvalCache(long samples, VerifyResult *result);
+void verifySplitPot(long samples, VerifyResult *result);
+void verifyAuditEcho(VerifyResult *result);
+void verifyValues(ValueEvaluator evaluator, ValueEvaluator reference,
+                  const DeckVariant *variant, int cardAmount, long samples,
+                  VerifyResult *result);
+int runVerification(long samples);
+void displayVerifyResult(const VerifyResult *result, wchar_t *message);
+
 // Display
 void setUnicodeMode();
 void displayCard(Card card);
 void displayDeck(const Card deck[], wchar_t *message);
+void displayCards(const Card cards[], int cardAmount, wchar_t *message);
 void displayHands(const Hand hands[], int players, int mode, wchar_t *message);
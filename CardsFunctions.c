@@ -49,24 +49,39 @@ void initializeDeck(Card *deck) {
  * Function displayDeck
  * Displays a formatted representation of the current state of the deck.
  *
+ * @param deck[]  Integer array deck of cards to be displayed
+ */
+
+void displayDeck(const Card deck[], wchar_t *message) {
+    displayCards(deck, DECK_SIZE, message);
+} // end function
+
+/**
+ * Function displayCards
+ * Displays a formatted representation of a deck of any size, one suit per
+ * line when the deck is ordered.
+ *
  * FORMULAS:
- * index % CARD_NUMBERS_AMOUNT == 0
- *    Use of the mod operator to display a line break every 13 cards.
+ * index % (cardAmount / CARD_TYPE_AMOUNT) == 0
+ *    Use of the mod operator to display a line break every quarter of the
+ *    deck, every 13 cards for a full deck.
  *
  * NOTE: wprintf is used instead of conventional print as display mode is set
  * to Unicode long char.
- * @param deck[]  Integer array deck of cards to be displayed
+ * @param cards[]      array of cards to be displayed
+ * @param cardAmount   amount of cards, a multiple of CARD_TYPE_AMOUNT
+ * @param message      header string to print before display
  */
 
-void displayDeck(const Card deck[], wchar_t *message) {
+void displayCards(const Card cards[], int cardAmount, wchar_t *message) {
     int index = 0;
 
     wprintf(L"%ls", message);
-    for (index = 0; index < DECK_SIZE; index++) {
-        if (index % CARD_NUMBERS_AMOUNT == 0) {
+    for (index = 0; index < cardAmount; index++) {
+        if (index % (cardAmount / CARD_TYPE_AMOUNT) == 0) {
             wprintf(L"\n");
         } // endif
-        displayCard(deck[index]);
+        displayCard(cards[index]);
     } // endfor
     wprintf(L"\n\n");
 } // end function
@@ -81,6 +96,10 @@ void displayDeck(const Card deck[], wchar_t *message) {
  */
 
 void displayCard(Card card) {
+    if (card.suit == JOKER) {
+        wprintf(L"[ JKR ] ");
+        return;
+    } // endif
     wprintf(L"[ %c-%lc ] ", CARD_NUM_SYMBOL[card.rank],
                             CARD_TYPE_SYMBOL[card.suit]);
 } // end function
@@ -101,15 +120,51 @@ void displayCard(Card card) {
  */
 
 void shuffleDeck(Card *deck) {
+    shuffleCards(deck, DECK_SIZE);
+} // end function
+
+/**
+ * Function shuffleCards
+ * Shuffles a deck of any size with the Knuth algorithm of shuffleDeck(), for
+ * deck variants.
+ *
+ * @param *deck      Pointer to an array deck of cards to be shuffled
+ * @param deckSize   Amount of cards in the deck
+ */
+
+void shuffleCards(Card *deck, int deckSize) {
     int index = 0;
     int randomIndex = 0;
 
-    for (index = DECK_SIZE - 1; index > 0; index--) {  //
+    for (index = deckSize - 1; index > 0; index--) {   //
         randomIndex = rand() % (index + 1);            // Knuth Algorithm
         swapCards(deck, index, randomIndex);           //
     } // endfor
 } // end function
 
+/**
+ * Function drawRandomCards
+ * Moves random cards to the front of a deck with only the first steps of
+ * the Knuth algorithm of shuffleDeck(), for when only the top cards of the
+ * shuffled deck are dealt.
+ *
+ * FORMULAS:
+ *  index + rand() % (deckSize - index)
+ *   Random position among the cards not yet drawn.
+ *
+ * @param *deck      Pointer to an array deck of cards to draw from
+ * @param deckSize   Amount of cards in the deck
+ * @param amount     Amount of cards to draw to the front
+ */
+
+void drawRandomCards(Card *deck, int deckSize, int amount) {
+    int index = 0;
+
+    for (index = 0; index < amount; index++) {
+        swapCards(deck, index, index + rand() % (deckSize - index));
+    } // endfor
+} // end function
+
 /**
  * Function swapElements
  * Swaps two elements at given indexes from an input array.
@@ -162,7 +217,8 @@ void drawHands(const Card deck[], Hand hands[], int players) {
  * Displays cards from all player's hands in a formatted representation.
  * argument mode can be set to DEFAULT, WITH_RANGE, TESTING or can be used
  * to display the winning hand by specifying the winning rank number in the
- * slot.
+ * slot. WITH_WINNERS marks instead the hands holding the best handValue,
+ * so kickers break ties between hands of the same rank.
  *
  * NOTE: wprintf is used instead of conventional print as display mode is set
  * to Unicode long char.
@@ -173,9 +229,14 @@ void drawHands(const Card deck[], Hand hands[], int players) {
  */
 
 void displayHands(const Hand hands[], int players, int mode, wchar_t *msg) {
+    HandValue winningValue = 0;
     int playerIndex = 0;
     int handIndex = 0;
 
+    if (mode == WITH_WINNERS) {
+        winningValue = getWinningValue(hands, players);
+    } // endif
+
     wprintf(L"Player Hands: %ls", msg);
     for (playerIndex = 0; playerIndex < players; playerIndex++) {
         if (mode == TESTING) {
@@ -191,7 +252,12 @@ void displayHands(const Hand hands[], int players, int mode, wchar_t *msg) {
 
         if (mode != DEFAULT) {
             wprintf(L" - %ls", POKER_RANK_STRING[hands[playerIndex].handRank]);
-            if (mode != WITH_RANK && mode != TESTING) {
+            if (mode == WITH_WINNERS) {
+                if (hands[playerIndex].handValue == winningValue) {
+                    wprintf(L" - winner");
+                } // endif
+            } // endif
+            else if (mode != WITH_RANK && mode != TESTING) {
                 PokerRank winningRank = mode;
                 if (hands[playerIndex].handRank == winningRank) {
                     wprintf(L" - winner");
@@ -242,11 +308,122 @@ void sortHands(Hand hands[], int players) {
 /**
  * Function getComparable
  * Returns an integer value for a given card to be used as comparison for
- * sorting.
+ * sorting. Jokers sort after every other card.
  *
  * @param card   card from which to calculate comparable value
  */
 
 int getComparable(Card card) {
+    if (card.suit == JOKER) {
+        return DECK_SIZE + card.rank;
+    } // endif
     return (card.rank * CARD_TYPE_AMOUNT) + card.suit;
 } // end function
+
+/**
+ * Function firstCombination
+ * Sets the indexes of the first combination in lexicographic order, which
+ * are the first chosen indexes.
+ *
+ * @param indexes   array of chosen indexes to set
+ * @param chosen    amount of chosen indexes
+ */
+
+void firstCombination(int indexes[], int chosen) {
+    int index = 0;
+
+    for (index = 0; index < chosen; index++) {
+        indexes[index] = index;
+    } // endfor
+} // end function
+
+/**
+ * Function nextCombination
+ * Advances an increasing array of chosen indexes to the next combination in
+ * lexicographic order.
+ *
+ * FORMULAS
+ *  total - chosen + index
+ *   Largest value the index at position index can take, so that every
+ *   following position still has a larger index available.
+ *
+ * @param indexes   array of chosen indexes, in increasing order
+ * @param chosen    amount of chosen indexes
+ * @param total     amount of elements to choose from
+ * @return          TRUE if advanced, FALSE if it was the last combination
+ */
+
+int nextCombination(int indexes[], int chosen, int total) {
+    int index = chosen - 1;
+
+    while (index >= 0 && indexes[index] == total - chosen + index) {
+        index--;
+    } // endwhile
+    if (index < 0) {
+        return FALSE;
+    } // endif
+    indexes[index]++;
+    for (index++; index < chosen; index++) {
+        indexes[index] = indexes[index - 1] + 1;
+    } // endfor
+    return TRUE;
+} // end function
+
+/**
+ * Function countCombinations
+ * Calculates the amount of combinations of chosen elements out of total.
+ *
+ * FORMULAS
+ *  count * (total - index) / (index + 1)
+ *   Builds total! / (chosen! * (total - chosen)!) one factor at a time,
+ *   every partial result being itself a whole binomial coefficient.
+ *
+ * @param total    amount of elements to choose from
+ * @param chosen   amount of chosen elements
+ * @return         amount of combinations, 0 if chosen exceeds total
+ */
+
+long long countCombinations(int total, int chosen) {
+    long long count = 1;
+    int index = 0;
+
+    for (index = 0; index < chosen; index++) {
+        count = count * (total - index) / (index + 1);
+    } // endfor
+    return (total < 0) ? 0 : count;
+} // end function
+
+/**
+ * Function unrankCombination
+ * Sets the indexes of the combination at a position of the lexicographic
+ * order of nextCombination(), so enumerations can start anywhere.
+ *
+ * FORMULAS
+ *  countCombinations(total - candidate - 1, chosen - position - 1)
+ *   Combinations whose index at position is candidate, skipped as a block
+ *   while the position to reach is past them.
+ *
+ * @param index     position of the combination, from 0
+ * @param indexes   array of chosen indexes to set
+ * @param chosen    amount of chosen indexes
+ * @param total     amount of elements to choose from
+ */
+
+void unrankCombination(long long index, int indexes[], int chosen,
+                       int total) {
+    int position = 0;
+    int candidate = 0;
+
+    for (position = 0; position < chosen; position++) {
+        long long block = countCombinations(total - candidate - 1,
+                                            chosen - position - 1);
+        while (index >= block) {
+            index -= block;
+            candidate++;
+            block = countCombinations(total - candidate - 1,
+                                      chosen - position - 1);
+        } // endwhile
+        indexes[position] = candidate;
+        candidate++;
+    } // endfor
+} // end function
@@ -107,6 +107,138 @@ int stringToInt(char *string) {
     return toInteger;
 } // end function
 
+/**
+ * Function validateCountArgument
+ * Checks if the given string argument is a positive integer, as used for
+ * iteration amounts of the program modes.
+ *
+ * @param argument  String argument input from argv.
+ * @return          The integer representation, or -1 if invalid
+ */
+
+long validateCountArgument(char *argument) {
+    long count = 0;
+
+    if (*argument == END_OF_STRING) {
+        return INVALID_INPUT;
+    } // endif
+    for (; *argument != END_OF_STRING; argument++) {
+        if (!isCharValidInteger(*argument)) {
+            return INVALID_INPUT;
+        } // endif
+        count = (count * 10) + (*argument - FIRST_CHAR_INTEGER);
+        if (count > MAX_COUNT_ARGUMENT) {
+            return INVALID_INPUT;
+        } // endif
+    } // endfor
+    return (count > 0) ? count : INVALID_INPUT;
+} // end function
+
+/**
+ * Function validateRealArgument
+ * Checks if the given string argument is a positive real number, such as
+ * 0.5, as used for precision and time arguments of the program modes.
+ *
+ * @param argument  String argument input from argv.
+ * @return          The real representation, or -1 if invalid
+ */
+
+double validateRealArgument(char *argument) {
+    char *end = NULL;
+    double real = strtod(argument, &end);
+
+    if (end == argument || *end != END_OF_STRING || !(real > 0)) {
+        return INVALID_INPUT;
+    } // endif
+    return real;
+} // end function
+
+/**
+ * Function parseCard
+ * Parses a card written as its rank symbol followed by its suit letter,
+ * such as "As" for the ace of spades or "Th" for the ten of hearts.
+ *
+ * @param text   string starting with the card
+ * @param card   card receiving the result
+ * @return       VALID_INPUT if parsed, INVALID_INPUT otherwise
+ */
+
+int parseCard(const char *text, Card *card) {
+    int rank = 0;
+    int suit = 0;
+
+    for (rank = 0; rank < CARD_NUMBERS_AMOUNT; rank++) {
+        if (text[0] == CARD_NUM_SYMBOL[rank]) {
+            break;
+        } // endif
+    } // endfor
+    if (rank == CARD_NUMBERS_AMOUNT) {
+        return INVALID_INPUT;
+    } // endif
+    for (suit = 0; suit < CARD_TYPE_AMOUNT; suit++) {
+        if (text[1] == CARD_SUIT_LETTER[suit]) {
+            break;
+        } // endif
+    } // endfor
+    if (suit == CARD_TYPE_AMOUNT) {
+        return INVALID_INPUT;
+    } // endif
+    card->rank = rank;
+    card->suit = suit;
+    return VALID_INPUT;
+} // end function
+
+/**
+ * Function parseCards
+ * Parses consecutive cards written as in parseCard(), such as "AsKd".
+ *
+ * @param text       string of cards, without separators
+ * @param cards      array receiving the cards
+ * @param maxCards   size of the cards array
+ * @return           amount of cards parsed, or INVALID_INPUT
+ */
+
+int parseCards(const char *text, Card cards[], int maxCards) {
+    int cardAmount = 0;
+
+    for (; *text != END_OF_STRING; text += CARD_TEXT_LEN) {
+        if (cardAmount == maxCards ||
+            parseCard(text, &cards[cardAmount]) == INVALID_INPUT) {
+            return INVALID_INPUT;
+        } // endif
+        cardAmount++;
+    } // endfor
+    return cardAmount;
+} // end function
+
+/**
+ * Function parseRanks
+ * Parses a list of different rank symbols, such as "AKQJT98" for the ranks
+ * from EIGHT to ACE, into a rank mask.
+ *
+ * @param text    string of rank symbols, without separators
+ * @param ranks   rank mask receiving the result, one bit per Rank
+ * @return        VALID_INPUT if parsed, INVALID_INPUT otherwise
+ */
+
+int parseRanks(const char *text, unsigned int *ranks) {
+    int rank = 0;
+
+    *ranks = 0;
+    for (; *text != END_OF_STRING; text++) {
+        for (rank = 0; rank < CARD_NUMBERS_AMOUNT; rank++) {
+            if (*text == CARD_NUM_SYMBOL[rank]) {
+                break;
+            } // endif
+        } // endfor
+        if (rank == CARD_NUMBERS_AMOUNT || (*ranks & (1 << rank))) {
+            return INVALID_INPUT;
+        } // endif
+        *ranks |= 1 << rank;
+    } // endfor
+    return (*ranks != 0) ? VALID_INPUT : INVALID_INPUT;
+} // end function
+
 /**
  * Function isCharValidInteger
  * Checks whether the input char represents a numeric digit.
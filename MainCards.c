@@ -8,12 +8,20 @@
    Compile/Run: make build
                 ./PokerHands.out *[NUMBER] **[NUMBER]
 
+                ./PokerHands.out [MODE] [ARGUMENTS...]
+
                 NOTE: Items with asterisk correspond to user input:
                 *: Integer from 1-13 to define cards per hand
                 **: Integer from 1-13 to define amount of players
+                MODE: Name of a program mode, see PokerModes.c
 
    Alternative: gcc MainCards.c CardsValidation.c CardsFunctions.c
-                PokerFunctions.c -o PokerHands.out
+                PokerFunctions.c PokerEvaluator.c PokerVerification.c
+                PokerModes.c PokerOmaha.c PokerLowball.c
+                PokerIsomorphism.c PokerStreets.c PokerOuts.c
+                PokerVariants.c PokerEquity.c PokerJobs.c
+                PokerCache.c PokerPushFold.c PokerAudit.c
+                -o PokerHands.out -lm -pthread
 
   Dependencies: This program requires the following files in the same
                 directory for proper compilation
@@ -21,6 +29,20 @@
                 - CardsValidation.c
                 - CardsFunctions.c
                 - PokerFunctions.c
+                - PokerEvaluator.c
+                - PokerVerification.c
+                - PokerModes.c
+                - PokerOmaha.c
+                - PokerLowball.c
+                - PokerIsomorphism.c
+                - PokerStreets.c
+                - PokerOuts.c
+                - PokerVariants.c
+                - PokerEquity.c
+                - PokerJobs.c
+                - PokerCache.c
+                - PokerPushFold.c
+                - PokerAudit.c
                 - Cards.h
 
   --------------------------------------------------------------------
@@ -73,6 +95,10 @@
 #include <time.h>     // Required for seed randomization
 
 int main(int argc, char *argv[]) {
+    /* Program Modes */
+    if (argc > MODE_INDEX && isProgramMode(argv[MODE_INDEX])) {
+        return runProgramMode(argc, argv);
+    } // endif
     /* Input Validation*/
     if (validateArguments(argc, argv) == INVALID_INPUT) {
         invalidInputTerminate();
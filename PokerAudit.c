@@ -0,0 +1,577 @@
+
+/*---------------------------------------------------------------------------*\
+
+   Source code:  PokerAudit.c
+        Author:  Marcel Riera
+
+   Description:  Source code containing the hand history audit. A hand
+                 history log holds one Hold'em showdown per line:
+
+                     Id;Board;Hole1 Hole2 [Hole3...];Winners
+
+                 such as 1042;AsKd7h2c9s;AhAd QcJc;1 where Winners are the
+                 seats sharing the pot, counted from 1 and separated by
+                 commas. Lines that are empty or start with COMMENT_MARK are
+                 not records. Every showdown is evaluated again and the hands
+                 whose recorded winners disagree are reported.
+
+                 The log is mapped in memory and split in chunks of about
+                 AUDIT_CHUNK_BYTES ending at a record boundary. Worker
+                 threads claim chunks in file order, optionally each with its
+                 own evaluation cache for logs replaying the same deals, and
+                 write their report to a buffer of the chunk, while the
+                 calling thread outputs the reports in file order as soon
+                 as they are done. Workers never run more than a window of
+                 chunks ahead of the output, so memory stays bounded
+                 whatever the size of the log. Bytes of the log echoed in a
+                 report are escaped, so any log prints on a wide stream.
+
+                 This file is required for compilation of PokerHands.out, and
+                 must be in the same folder with MainCards.c, CardsValidation.c,
+                 CardsFunctions.c, PokerFunctions.c and Cards.h
+
+\*---------------------------------------------------------------------------*/
+
+#include "Cards.h"      // Required program header
+#include <stdarg.h>     // Required for appendReport() arguments
+#include <string.h>     // Required for memchr()
+#include <fcntl.h>      // Required for open()
+#include <sys/mman.h>   // Required for mmap()
+#include <sys/stat.h>   // Required for fstat()
+#include <unistd.h>     // Required for close()
+
+/**
+ * Function findSeparator
+ * Finds the first separator in a range of text.
+ *
+ * @param text        first byte of the range
+ * @param end         byte after the range
+ * @param separator   character to find
+ * @return            the separator, or end if there is none
+ */
+
+static const char *findSeparator(const char *text, const char *end,
+                                 char separator) {
+    const char *found = memchr(text, separator, end - text);
+
+    return (found == NULL) ? end : found;
+} // end function
+
+/**
+ * Function parseCardRange
+ * Parses consecutive cards written as in parseCard(), in a range of text
+ * that is not NUL terminated.
+ *
+ * @param text       first byte of the range
+ * @param end        byte after the range
+ * @param cards      array receiving the cards
+ * @param maxCards   size of the cards array
+ * @return           amount of cards parsed, or INVALID_INPUT
+ */
+
+static int parseCardRange(const char *text, const char *end, Card cards[],
+                          int maxCards) {
+    int cardAmount = 0;
+
+    for (; text < end; text += CARD_TEXT_LEN) {
+        if (cardAmount == maxCards || end - text < CARD_TEXT_LEN ||
+            parseCard(text, &cards[cardAmount]) == INVALID_INPUT) {
+            return INVALID_INPUT;
+        } // endif
+        cardAmount++;
+    } // endfor
+    return cardAmount;
+} // end function
+
+/**
+ * Function parseWinners
+ * Parses the winning seats of a record, counted from 1.
+ *
+ * @param text    first byte of the winners field
+ * @param end     byte after the field
+ * @param seats   amount of seats in the record
+ * @return        winning seats, one bit per seat from bit 0, or 0 if invalid
+ */
+
+static unsigned int parseWinners(const char *text, const char *end,
+                                 int seats) {
+    unsigned int winners = 0;
+
+    while (text < end) {
+        const char *numberEnd = findSeparator(text, end, WINNER_SEPARATOR);
+        int seat = 0;
+
+        if (numberEnd == text) {
+            return 0;
+        } // endif
+        for (; text < numberEnd; text++) {
+            if (!isCharValidInteger(*text) || seat > seats) {
+                return 0;
+            } // endif
+            seat = seat * 10 + (*text - FIRST_CHAR_INTEGER);
+        } // endfor
+        if (seat < 1 || seat > seats) {
+            return 0;
+        } // endif
+        winners |= 1 << (seat - 1);
+        text = (numberEnd < end) ? numberEnd + 1 : end;
+    } // endwhile
+    return winners;
+} // end function
+
+/**
+ * Function formatSeats
+ * Writes a set of seats as in the winners field, such as "1,3".
+ *
+ * @param seats    one bit per seat from bit 0
+ * @param buffer   buffer of at least 3 * MAX_PLAYERS bytes
+ */
+
+static void formatSeats(unsigned int seats, char buffer[]) {
+    int length = 0;
+    int seat = 0;
+
+    buffer[0] = END_OF_STRING;
+    for (seat = 0; seat < MAX_PLAYERS; seat++) {
+        if (seats & (1 << seat)) {
+            length += sprintf(buffer + length, (length > 0) ? ",%d" : "%d",
+                              seat + 1);
+        } // endif
+    } // endfor
+} // end function
+
+/**
+ * Function escapeEcho
+ * Copies up to AUDIT_ECHO_LEN bytes of a record for a report, writing the
+ * bytes that are not printable ASCII, and backslashes, as \xNN so that a
+ * log in any encoding prints on a wide stream.
+ *
+ * @param text     first byte to echo
+ * @param end      byte after the last byte to echo
+ * @param buffer   array of AUDIT_ESCAPED_LEN characters receiving the text
+ */
+
+static void escapeEcho(const char *text, const char *end, char buffer[]) {
+    int length = 0;
+
+    if (end - text > AUDIT_ECHO_LEN) {
+        end = text + AUDIT_ECHO_LEN;
+    } // endif
+    for (; text < end; text++) {
+        unsigned char byte = (unsigned char) *text;
+        if (byte < ' ' || byte > '~' || byte == '\\') {
+            length += sprintf(buffer + length, "\\x%02X", byte);
+        } // endif
+        else {
+            buffer[length] = byte;
+            length++;
+        } // endelse
+    } // endfor
+    buffer[length] = '\0';
+} // end function
+
+/**
+ * Function appendReport
+ * Appends a formatted line to the report of a chunk, growing it as needed.
+ * The report stays NUL terminated. A line that does not fit in memory is
+ * dropped.
+ *
+ * @param chunk    chunk whose report receives the line
+ * @param format   printf() format of the line
+ */
+
+static void appendReport(AuditChunk *chunk, const char *format, ...) {
+    va_list arguments;
+    int length = 0;
+
+    va_start(arguments, format);
+    length = vsnprintf(NULL, 0, format, arguments);
+    va_end(arguments);
+    if (chunk->reportLength + length + 1 > chunk->reportCapacity) {
+        long capacity = 2 * chunk->reportCapacity + length + 1;
+        char *report = realloc(chunk->report, capacity);
+        if (report == NULL) {
+            return;
+        } // endif
+        chunk->report = report;
+        chunk->reportCapacity = capacity;
+    } // endif
+    va_start(arguments, format);
+    vsnprintf(chunk->report + chunk->reportLength, length + 1, format,
+              arguments);
+    va_end(arguments);
+    chunk->reportLength += length;
+} // end function
+
+/**
+ * Function auditRecord
+ * Evaluates the showdown of one record and reports it if its recorded
+ * winners are not the players with the best hand, or if it cannot be read.
+ * The id, or the start of an unreadable record, is echoed through
+ * escapeEcho().
+ *
+ * @param chunk   chunk of the record, receiving its counters and report
+ * @param cache   evaluation cache of the calling thread, NULL for none
+ * @param line    first byte of the record
+ * @param end     byte after the record, without its line end
+ */
+
+void auditRecord(AuditChunk *chunk, EvalCache *cache, const char *line,
+                 const char *end) {
+    Card cards[BOARD_SIZE] = {};
+    HandValue values[MAX_PLAYERS] = {};
+    CardMask holes[MAX_PLAYERS] = {};
+    char echo[AUDIT_ESCAPED_LEN] = {};
+    CardMask board = 0;
+    CardMask known = 0;
+    HandValue bestValue = 0;
+    const char *idEnd = findSeparator(line, end, FIELD_SEPARATOR);
+    const char *boardEnd = findSeparator(idEnd + (idEnd < end), end,
+                                         FIELD_SEPARATOR);
+    const char *seatsEnd = findSeparator(boardEnd + (boardEnd < end), end,
+                                         FIELD_SEPARATOR);
+    const char *seat = boardEnd + 1;
+    unsigned int recorded = 0;
+    unsigned int evaluated = 0;
+    int players = 0;
+    int player = 0;
+    int valid = (seatsEnd < end);
+
+    if (valid) {
+        valid = (parseCardRange(idEnd + 1, boardEnd, cards, BOARD_SIZE) ==
+                 BOARD_SIZE);
+        board = cardsToMask(cards, BOARD_SIZE);
+        known = board;
+    } // endif
+    while (valid && seat < seatsEnd) {
+        const char *seatEnd = findSeparator(seat, seatsEnd, SEAT_SEPARATOR);
+        if (seatEnd > seat) {
+            valid = (players < MAX_PLAYERS &&
+                     parseCardRange(seat, seatEnd, cards, HOLDEM_HOLE_SIZE) ==
+                     HOLDEM_HOLE_SIZE);
+            if (valid) {
+                holes[players] = cardsToMask(cards, HOLDEM_HOLE_SIZE);
+                known |= holes[players];
+                players++;
+            } // endif
+        } // endif
+        seat = seatEnd + 1;
+    } // endwhile
+    if (valid) {
+        recorded = parseWinners(seatsEnd + 1, end, players);
+        valid = (players >= 2 && recorded != 0 && __builtin_popcountll(known)
+                 == BOARD_SIZE + players * HOLDEM_HOLE_SIZE);
+    } // endif
+    if (!valid) {
+        escapeEcho(line, end, echo);
+        appendReport(chunk, "Invalid record: %s\n", echo);
+        chunk->invalid++;
+        return;
+    } // endif
+
+    for (player = 0; player < players; player++) {
+        values[player] = (cache != NULL) ?
+                         evaluateMaskCached(cache, board | holes[player]) :
+                         evaluateMask(board | holes[player]);
+        if (values[player] > bestValue) {
+            bestValue = values[player];
+            evaluated = 0;
+        } // endif
+        if (values[player] == bestValue) {
+            evaluated |= 1 << player;
+        } // endif
+    } // endfor
+    chunk->records++;
+    if (recorded != evaluated) {
+        char recordedText[3 * MAX_PLAYERS] = {};
+        char evaluatedText[3 * MAX_PLAYERS] = {};
+        formatSeats(recorded, recordedText);
+        formatSeats(evaluated, evaluatedText);
+        escapeEcho(line, idEnd, echo);
+        appendReport(chunk, "Hand %s - recorded %s, evaluated %s with %ls\n",
+                     echo, recordedText, evaluatedText,
+                     POKER_RANK_STRING[bestValue >> HAND_VALUE_SHIFT]);
+        chunk->mismatches++;
+    } // endif
+} // end function
+
+/**
+ * Function auditChunk
+ * Audits every record of a chunk, skipping empty lines and comments.
+ *
+ * @param chunk   chunk to audit
+ * @param cache   evaluation cache of the calling thread, NULL for none
+ */
+
+static void auditChunk(AuditChunk *chunk, EvalCache *cache) {
+    const char *line = chunk->begin;
+
+    while (line < chunk->end) {
+        const char *lineEnd = findSeparator(line, chunk->end, '\n');
+        const char *next = lineEnd + 1;
+
+        if (lineEnd > line && lineEnd[-1] == '\r') {
+            lineEnd--;
+        } // endif
+        if (lineEnd > line && *line != COMMENT_MARK) {
+            auditRecord(chunk, cache, line, lineEnd);
+        } // endif
+        line = next;
+    } // endwhile
+} // end function
+
+/**
+ * Function splitAuditChunks
+ * Splits a log in chunks of about AUDIT_CHUNK_BYTES, each ending after a
+ * line end, so no record is split between two chunks.
+ *
+ * @param job    job receiving the chunks, to release with free()
+ * @param data   contents of the log
+ * @param size   size of the log in bytes
+ * @return       VALID_INPUT, or INVALID_INPUT if out of memory
+ */
+
+int splitAuditChunks(AuditJob *job, const char *data, long size) {
+    const char *begin = data;
+    const char *end = data + size;
+
+    job->chunkAmount = 0;
+    job->chunks = calloc(size / AUDIT_CHUNK_BYTES + 1, sizeof(AuditChunk));
+    if (job->chunks == NULL) {
+        return INVALID_INPUT;
+    } // endif
+    while (begin < end) {
+        AuditChunk *chunk = &job->chunks[job->chunkAmount];
+        chunk->begin = begin;
+        chunk->end = end;
+        if (end - begin > AUDIT_CHUNK_BYTES) {
+            chunk->end = findSeparator(begin + AUDIT_CHUNK_BYTES, end, '\n');
+            chunk->end += (chunk->end < end);
+        } // endif
+        begin = chunk->end;
+        job->chunkAmount++;
+    } // endwhile
+    return VALID_INPUT;
+} // end function
+
+/**
+ * Function runAuditChunks
+ * Worker thread claiming and auditing chunks in file order, while they are
+ * within the window ahead of the output.
+ *
+ * @param argument   AuditTask of the thread
+ * @return           NULL
+ */
+
+static void *runAuditChunks(void *argument) {
+    AuditTask *task = argument;
+    AuditJob *job = task->job;
+
+    while (TRUE) {
+        AuditChunk *chunk = NULL;
+
+        pthread_mutex_lock(&job->lock);
+        while (job->nextChunk < job->chunkAmount &&
+               job->nextChunk >= job->written + job->window) {
+            pthread_cond_wait(&job->changed, &job->lock);
+        } // endwhile
+        if (job->nextChunk == job->chunkAmount) {
+            pthread_mutex_unlock(&job->lock);
+            return NULL;
+        } // endif
+        chunk = &job->chunks[job->nextChunk];
+        job->nextChunk++;
+        pthread_mutex_unlock(&job->lock);
+
+        auditChunk(chunk, job->useCache ? &job->caches[task->thread] : NULL);
+
+        pthread_mutex_lock(&job->lock);
+        chunk->done = TRUE;
+        pthread_cond_broadcast(&job->changed);
+        pthread_mutex_unlock(&job->lock);
+    } // endwhile
+} // end function
+
+/**
+ * Function writeAuditChunks
+ * Outputs the report of every chunk in file order as soon as it is done,
+ * adding its counters to the totals and releasing it.
+ *
+ * @param job      job being audited
+ * @param totals   chunk receiving the total counters
+ */
+
+static void writeAuditChunks(AuditJob *job, AuditChunk *totals) {
+    int index = 0;
+
+    for (index = 0; index < job->chunkAmount; index++) {
+        AuditChunk *chunk = &job->chunks[index];
+
+        pthread_mutex_lock(&job->lock);
+        while (!chunk->done) {
+            pthread_cond_wait(&job->changed, &job->lock);
+        } // endwhile
+        pthread_mutex_unlock(&job->lock);
+
+        if (chunk->report != NULL) {
+            wprintf(L"%s", chunk->report);
+            free(chunk->report);
+            chunk->report = NULL;
+        } // endif
+        totals->records += chunk->records;
+        totals->mismatches += chunk->mismatches;
+        totals->invalid += chunk->invalid;
+
+        pthread_mutex_lock(&job->lock);
+        job->written++;
+        pthread_cond_broadcast(&job->changed);
+        pthread_mutex_unlock(&job->lock);
+    } // endfor
+} // end function
+
+/**
+ * Function runAudit
+ * Audits a log in memory on worker threads, outputting its reports in file
+ * order. Runs on the calling thread if no thread can start. Random deals
+ * seldom repeat, so each thread gets an evaluation cache only on request.
+ *
+ * @param data          contents of the log
+ * @param size          size of the log in bytes
+ * @param threads       amount of worker threads, from 1 to MAX_THREADS
+ * @param totals        chunk receiving the total counters
+ * @param cacheTotals   cache receiving the hits and misses of all threads,
+ *                      or NULL to evaluate without caches
+ * @return              VALID_INPUT, or INVALID_INPUT if out of memory
+ */
+
+int runAudit(const char *data, long size, int threads, AuditChunk *totals,
+             EvalCache *cacheTotals) {
+    AuditJob *job = calloc(1, sizeof(AuditJob));
+    pthread_t ids[MAX_THREADS] = {};
+    AuditTask tasks[MAX_THREADS] = {};
+    int started[MAX_THREADS] = {};
+    int valid = (job != NULL && splitAuditChunks(job, data, size) ==
+                 VALID_INPUT);
+    int startedAmount = 0;
+    int thread = 0;
+
+    for (thread = 0; valid && cacheTotals != NULL && thread < threads;
+         thread++) {
+        valid = createEvalCache(&job->caches[thread], EVAL_CACHE_SLOTS);
+    } // endfor
+    if (!valid) {
+        for (thread = 0; job != NULL && thread < threads; thread++) {
+            freeEvalCache(&job->caches[thread]);
+        } // endfor
+        if (job != NULL) {
+            free(job->chunks);
+        } // endif
+        free(job);
+        return INVALID_INPUT;
+    } // endif
+
+    job->useCache = (cacheTotals != NULL);
+    job->window = threads * AUDIT_WINDOW_CHUNKS;
+    pthread_mutex_init(&job->lock, NULL);
+    pthread_cond_init(&job->changed, NULL);
+    for (thread = 0; thread < threads; thread++) {
+        tasks[thread].job = job;
+        tasks[thread].thread = thread;
+        started[thread] = (pthread_create(&ids[thread], NULL, runAuditChunks,
+                                          &tasks[thread]) == 0);
+        startedAmount += started[thread];
+    } // endfor
+    if (startedAmount == 0) {
+        job->window = job->chunkAmount;   // Nothing to wait for
+        runAuditChunks(&tasks[0]);
+    } // endif
+    writeAuditChunks(job, totals);
+
+    for (thread = 0; thread < threads; thread++) {
+        if (started[thread]) {
+            pthread_join(ids[thread], NULL);
+        } // endif
+        if (job->useCache) {
+            cacheTotals->hits += job->caches[thread].hits;
+            cacheTotals->misses += job->caches[thread].misses;
+            freeEvalCache(&job->caches[thread]);
+        } // endif
+    } // endfor
+    pthread_cond_destroy(&job->changed);
+    pthread_mutex_destroy(&job->lock);
+    free(job->chunks);
+    free(job);
+    return VALID_INPUT;
+} // end function
+
+/**
+ * Function auditFile
+ * Maps a hand history log in memory and audits it. See runAudit().
+ *
+ * @param path          path of the log
+ * @param threads       amount of worker threads, from 1 to MAX_THREADS
+ * @param totals        chunk receiving the total counters
+ * @param cacheTotals   cache receiving the hits and misses of all threads,
+ *                      or NULL to evaluate without caches
+ * @return              size of the log in bytes, or INVALID_INPUT
+ */
+
+long auditFile(const char *path, int threads, AuditChunk *totals,
+               EvalCache *cacheTotals) {
+    struct stat status;
+    const char *data = "";
+    int descriptor = open(path, O_RDONLY);
+    long size = 0;
+    int valid = FALSE;
+
+    if (descriptor < 0) {
+        return INVALID_INPUT;
+    } // endif
+    if (fstat(descriptor, &status) != 0) {
+        close(descriptor);
+        return INVALID_INPUT;
+    } // endif
+    size = status.st_size;
+    if (size > 0) {
+        data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (data == MAP_FAILED) {
+            close(descriptor);
+            return INVALID_INPUT;
+        } // endif
+        madvise((void *) data, size, MADV_SEQUENTIAL);
+    } // endif
+    close(descriptor);  // The mapping stays valid
+
+    valid = runAudit(data, size, threads, totals, cacheTotals);
+    if (size > 0) {
+        munmap((void *) data, size);
+    } // endif
+    return (valid == VALID_INPUT) ? size : INVALID_INPUT;
+} // end function
+
+/**
+ * Function displayAudit
+ * Displays the totals of an audit, its throughput and cache counters.
+ *
+ * @param totals        total counters
+ * @param cacheTotals   hits and misses of all threads, NULL without caches
+ * @param size          size of the log in bytes
+ * @param seconds       time the audit took
+ */
+
+void displayAudit(const AuditChunk *totals, const EvalCache *cacheTotals,
+                  long size, double seconds) {
+    double megabytes = size / 1048576.0;
+
+    wprintf(L"%ld showdowns audited, %ld mismatches, %ld invalid records\n",
+            totals->records, totals->mismatches, totals->invalid);
+    wprintf(L"%.1f MB in %.2f seconds", megabytes, seconds);
+    if (seconds > 0) {
+        wprintf(L" (%.1f MB/s, %.0f showdowns/s)", megabytes / seconds,
+                totals->records / seconds);
+    } // endif
+    wprintf(L"\n");
+    if (cacheTotals != NULL) {
+        displayEvalCache(cacheTotals, L"Evaluation cache:");
+    } // endif
+} // end function
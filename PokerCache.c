@@ -0,0 +1,175 @@
+
+/*---------------------------------------------------------------------------*\
+
+   Source code:  PokerCache.c
+        Author:  Marcel Riera
+
+   Description:  Source code containing a fixed size evaluation cache keyed
+                 by card mask, for workloads evaluating the same cards over
+                 and over, such as replays of the same deals. Random deals
+                 seldom repeat a seven card mask, so the cache is a layer
+                 callers opt into with evaluateMaskCached(). The cache is
+                 an open addressing table that never grows: each mask probes
+                 EVAL_CACHE_PROBES slots and replaces the first one when all
+                 are taken. A cache has no locks, so each thread owns its
+                 own, and its hit and miss counters tell whether it pays off.
+
+                 This file is required for compilation of PokerHands.out, and
+                 must be in the same folder with MainCards.c, CardsValidation.c,
+                 CardsFunctions.c, PokerFunctions.c and Cards.h
+
+\*---------------------------------------------------------------------------*/
+
+#include "Cards.h"      // Required program header
+
+/**
+ * Function createEvalCache
+ * Allocates an empty evaluation cache.
+ *
+ * @param cache      cache to create
+ * @param capacity   least amount of slots, rounded up to a power of two
+ * @return           TRUE if allocated, FALSE otherwise
+ */
+
+int createEvalCache(EvalCache *cache, long capacity) {
+    cache->capacity = 1;
+    cache->shift = 64;
+    while (cache->capacity < capacity) {
+        cache->capacity <<= 1;
+        cache->shift--;
+    } // endwhile
+    cache->hits = 0;
+    cache->misses = 0;
+    cache->entries = calloc(cache->capacity, sizeof(EvalCacheEntry));
+    return (cache->entries != NULL);
+} // end function
+
+/**
+ * Function freeEvalCache
+ * Releases the memory of an evaluation cache.
+ *
+ * @param cache   cache to release
+ */
+
+void freeEvalCache(EvalCache *cache) {
+    free(cache->entries);
+    cache->entries = NULL;
+    cache->capacity = 0;
+} // end function
+
+/**
+ * Function getCacheSlot
+ * Calculates the first slot a card mask probes.
+ *
+ * FORMULAS
+ *  (mask * HASH_MULTIPLIER) >> shift
+ *   Fibonacci hashing: the top bits of the product mix every card.
+ *
+ * @param cache   cache of the slot
+ * @param mask    card mask
+ * @return        first slot to probe
+ */
+
+static long getCacheSlot(const EvalCache *cache, CardMask mask) {
+    if (cache->shift == 64) {
+        return 0;   // A single slot, shifting by 64 is undefined
+    } // endif
+    return (long) ((mask * HASH_MULTIPLIER) >> cache->shift);
+} // end function
+
+/**
+ * Function lookupEvalCache
+ * Looks up the value stored for a card mask, counting a hit or a miss.
+ *
+ * @param cache   cache to search
+ * @param mask    card mask, not 0
+ * @param value   value receiving the stored result on a hit
+ * @return        TRUE on a hit, FALSE on a miss
+ */
+
+int lookupEvalCache(EvalCache *cache, CardMask mask, HandValue *value) {
+    long slot = getCacheSlot(cache, mask);
+    int probe = 0;
+
+    for (probe = 0; probe < EVAL_CACHE_PROBES; probe++) {
+        const EvalCacheEntry *entry = &cache->entries[slot];
+        if (entry->mask == mask) {
+            *value = entry->value;
+            cache->hits++;
+            return TRUE;
+        } // endif
+        if (entry->mask == 0) {
+            break;
+        } // endif
+        slot = (slot + 1) & (cache->capacity - 1);
+    } // endfor
+    cache->misses++;
+    return FALSE;
+} // end function
+
+/**
+ * Function storeEvalCache
+ * Stores the value of a card mask in the first free slot it probes, or in
+ * its first slot when all are taken.
+ *
+ * @param cache   cache to store in
+ * @param mask    card mask, not 0
+ * @param value   value to store
+ */
+
+void storeEvalCache(EvalCache *cache, CardMask mask, HandValue value) {
+    long first = getCacheSlot(cache, mask);
+    long slot = first;
+    int probe = 0;
+
+    for (probe = 0; probe < EVAL_CACHE_PROBES; probe++) {
+        if (cache->entries[slot].mask == 0 ||
+            cache->entries[slot].mask == mask) {
+            break;
+        } // endif
+        slot = (slot + 1) & (cache->capacity - 1);
+    } // endfor
+    if (probe == EVAL_CACHE_PROBES) {
+        slot = first;
+    } // endif
+    cache->entries[slot].mask = mask;
+    cache->entries[slot].value = value;
+} // end function
+
+/**
+ * Function evaluateMaskCached
+ * Evaluates a card mask with evaluateMask(), through a cache holding only
+ * values of evaluateMask().
+ *
+ * @param cache   cache of evaluateMask() values
+ * @param mask    card mask of 5 to MAX_EVAL_CARDS cards
+ * @return        comparable hand value
+ */
+
+HandValue evaluateMaskCached(EvalCache *cache, CardMask mask) {
+    HandValue value = 0;
+
+    if (!lookupEvalCache(cache, mask, &value)) {
+        value = evaluateMask(mask);
+        storeEvalCache(cache, mask, value);
+    } // endif
+    return value;
+} // end function
+
+/**
+ * Function displayEvalCache
+ * Displays the hit and miss counters of a cache.
+ *
+ * @param cache     cache to display
+ * @param message   header string to print before display
+ */
+
+void displayEvalCache(const EvalCache *cache, wchar_t *message) {
+    long lookups = cache->hits + cache->misses;
+
+    wprintf(L"%ls %ld hits, %ld misses", message, cache->hits, cache->misses);
+    if (lookups > 0) {
+        wprintf(L" (%.1f%% hit rate)", 100.0 * cache->hits / lookups);
+    } // endif
+    wprintf(L"\n");
+} // end function
@@ -0,0 +1,156 @@
+
+/*---------------------------------------------------------------------------*\
+
+   Source code:  PokerEquity.c
+        Author:  Marcel Riera
+
+   Description:  Source code containing adaptive Monte Carlo equity for
+                 Hold'em deals with known hole cards. Rather than a fixed
+                 amount of deals, boards are sampled in batches while the
+                 running sum of each player's share of the pot is kept, and
+                 sampling stops as soon as every 95% Agresti-Coull
+                 confidence interval is narrower than requested or the time
+                 budget is spent. Clear matchups stop after a few batches,
+                 close ones keep sampling up to the requested precision.
+
+                 This file is required for compilation of PokerHands.out, and
+                 must be in the same folder with MainCards.c, CardsValidation.c,
+                 CardsFunctions.c, PokerFunctions.c and Cards.h
+
+\*---------------------------------------------------------------------------*/
+
+#include "Cards.h"      // Required program header
+#include <math.h>       // Required for sqrt()
+#include <time.h>       // Required for the time budget
+
+/**
+ * Function calcAdaptiveEquity
+ * Samples random boards for Hold'em players until the 95% confidence
+ * interval of every player's equity is narrower than the given width, or
+ * the time budget is spent. Ties split the pot evenly. The stopping checks
+ * run between batches of EQUITY_BATCH_DEALS deals, out of the dealing loop.
+ * The Agresti-Coull interval adds z * z / 2 wins and losses to the sample,
+ * so it does not collapse to zero width when every deal so far had the
+ * same outcome. A share of the pot lies between 0 and 1, so its variance
+ * is at most the one of a win or loss with the same mean, which keeps the
+ * interval valid with split pots. A complete board is exact after a batch.
+ *
+ * FORMULAS
+ *  adjusted = deals + z * z
+ *  center = (sums + z * z / 2) / adjusted
+ *   Sample size and equity with the added wins and losses.
+ *
+ *  z * sqrt(center * (1 - center) / adjusted)
+ *   Half width of the 95% confidence interval of the equity.
+ *
+ * @param holes         HOLDEM_HOLE_SIZE hole cards per player, one player
+ *                      after the other
+ * @param players       amount of players, from 2 to MAX_PLAYERS
+ * @param board         known board cards
+ * @param boardAmount   amount of known board cards, up to BOARD_SIZE
+ * @param width         largest interval width accepted, as a fraction
+ * @param seconds       largest processor time to spend
+ * @param result        equity result to fill
+ * @return              VALID_INPUT, or INVALID_INPUT for an invalid deal
+ */
+
+int calcAdaptiveEquity(const Card holes[], int players, const Card board[],
+                       int boardAmount, double width, double seconds,
+                       EquityResult *result) {
+    Card unseen[DECK_SIZE] = {};
+    CardMask holeMasks[MAX_PLAYERS] = {};
+    HandValue values[MAX_PLAYERS] = {};
+    double sums[MAX_PLAYERS] = {};
+    double zSquared = EQUITY_Z_SCORE * EQUITY_Z_SCORE;
+    CardMask boardMask = cardsToMask(board, boardAmount);
+    CardMask known = boardMask;
+    int missing = BOARD_SIZE - boardAmount;
+    int unseenAmount = 0;
+    double widest = 0;
+    clock_t start = clock();
+    int player = 0;
+    int bit = 0;
+    long deal = 0;
+
+    if (players < 2 || players > MAX_PLAYERS || boardAmount < 0 ||
+        boardAmount > BOARD_SIZE) {
+        return INVALID_INPUT;
+    } // endif
+    for (player = 0; player < players; player++) {
+        holeMasks[player] = cardsToMask(holes + (player * HOLDEM_HOLE_SIZE),
+                                        HOLDEM_HOLE_SIZE);
+        known |= holeMasks[player];
+    } // endfor
+    if (__builtin_popcountll(known) !=
+        players * HOLDEM_HOLE_SIZE + boardAmount) {
+        return INVALID_INPUT;   // Repeated cards
+    } // endif
+    for (bit = 0; bit < DECK_SIZE; bit++) {
+        if (!(known & (1ULL << bit))) {
+            unseen[unseenAmount] = getMaskCard(bit);
+            unseenAmount++;
+        } // endif
+    } // endfor
+
+    result->deals = 0;
+    do {
+        for (deal = 0; deal < EQUITY_BATCH_DEALS; deal++) {
+            CardMask dealt = 0;
+            HandValue bestValue = 0;
+            int winners = 0;
+
+            drawRandomCards(unseen, unseenAmount, missing);
+            dealt = boardMask | cardsToMask(unseen, missing);
+            for (player = 0; player < players; player++) {
+                values[player] = evaluateMask(dealt | holeMasks[player]);
+                if (values[player] > bestValue) {
+                    bestValue = values[player];
+                    winners = 0;
+                } // endif
+                winners += (values[player] == bestValue);
+            } // endfor
+            for (player = 0; player < players; player++) {
+                if (values[player] == bestValue) {
+                    sums[player] += 1.0 / winners;
+                } // endif
+            } // endfor
+        } // endfor
+        result->deals += EQUITY_BATCH_DEALS;
+
+        widest = 0;
+        for (player = 0; player < players; player++) {
+            double adjusted = result->deals + zSquared;
+            double center = (sums[player] + zSquared / 2) / adjusted;
+            result->equity[player] = sums[player] / result->deals;
+            result->errorBound[player] = 0;
+            if (missing > 0) {
+                result->errorBound[player] = EQUITY_Z_SCORE *
+                                             sqrt(center * (1 - center) /
+                                                  adjusted);
+            } // endif
+            widest = fmax(widest, 2 * result->errorBound[player]);
+        } // endfor
+        result->seconds = (double) (clock() - start) / CLOCKS_PER_SEC;
+    } while (widest > width && result->seconds < seconds);
+    return VALID_INPUT;
+} // end function
+
+/**
+ * Function displayEquity
+ * Displays the equity of every player with its error bound.
+ *
+ * @param result    equity result to display
+ * @param players   amount of players
+ */
+
+void displayEquity(const EquityResult *result, int players) {
+    int player = 0;
+
+    for (player = 0; player < players; player++) {
+        wprintf(L"Player  %d] - equity %6.2f%% +/- %.2f%%\n", player + 1,
+                result->equity[player] * 100,
+                result->errorBound[player] * 100);
+    } // endfor
+    wprintf(L"%ld deals sampled in %.3f seconds (95%% confidence)\n",
+            result->deals, result->seconds);
+} // end function
@@ -0,0 +1,516 @@
+
+/*---------------------------------------------------------------------------*\
+
+   Source code:  PokerEvaluator.c
+        Author:  Marcel Riera
+
+   Description:  Source code containing a bitmask based poker hand evaluator.
+                 Hands of five to seven cards are reduced to one 13 bit rank
+                 mask per suit, and every poker rank is found with a few
+                 bitwise operations and two lookup tables instead of sorting
+                 the cards and running the isStraightFlush()...isOnePair()
+                 cascade, which remains the reference implementation.
+
+                 This file is required for compilation of PokerHands.out, and
+                 must be in the same folder with MainCards.c, CardsValidation.c,
+                 CardsFunctions.c, PokerFunctions.c and Cards.h
+
+\*---------------------------------------------------------------------------*/
+
+#include "Cards.h"      // Required program header
+
+#define TOP_RANKS_AMOUNT 5      // Ranks stored for each mask in topRanks
+#define WHEEL_HIGH 3            // High rank of the wheel A-2-3-4-5 (FIVE)
+#define WHEEL_MASK 0x100F       // Ranks A, 2, 3, 4 and 5 as a high rank mask
+#define SHORT_WHEEL_HIGH 7      // High rank of the short deck A-6-7-8-9
+#define SHORT_WHEEL_MASK 0x10F0 // Ranks A, 6, 7, 8 and 9 as a high rank mask
+#define STRAIGHT_MASK 0x1F      // Five consecutive ranks at the bottom
+
+static unsigned char straightTable[RANK_MASK_AMOUNT]; // High rank + 1, or 0
+static unsigned char shortStraightTable[RANK_MASK_AMOUNT]; // Short deck
+static unsigned int topRanksTable[RANK_MASK_AMOUNT];  // Packed top 5 ranks
+static unsigned char wildStraightTables[MAX_STRAIGHT_WILDS + 1]
+                                       [RANK_MASK_AMOUNT]; // By wild cards
+
+/**
+ * Function fillStraightTable
+ * Fills a straight table with the high rank plus one of the best straight
+ * in each rank mask, or 0 when there is none. Each deck variant has its own
+ * table, as the ace completes a different low straight, and each amount of
+ * wild cards too, as they fill the missing ranks of a straight.
+ *
+ * FORMULAS
+ *  STRAIGHT_MASK << (high - 4)
+ *   The five consecutive ranks ending at rank high.
+ *
+ *  popcount(window & ~mask)
+ *   Ranks of the straight missing from the mask, to be filled by wild cards.
+ *
+ * @param table       table of RANK_MASK_AMOUNT entries to fill
+ * @param wheelMask   ranks of the straight where the ace plays low
+ * @param wheelHigh   high rank of that straight
+ * @param wilds       amount of wild cards, 0 for natural straights
+ */
+
+static void fillStraightTable(unsigned char table[], unsigned int wheelMask,
+                              int wheelHigh, int wilds) {
+    int mask = 0;
+    int high = 0;
+
+    for (mask = 0; mask < RANK_MASK_AMOUNT; mask++) {
+        table[mask] = 0;
+        for (high = CARD_NUMBERS_AMOUNT - 1; high >= 4; high--) {
+            int window = STRAIGHT_MASK << (high - 4);
+            if (table[mask] == 0 &&
+                __builtin_popcount(window & ~mask) <= wilds) {
+                table[mask] = high + 1;
+            } // endif
+        } // endfor
+        if (__builtin_popcount(wheelMask & ~mask) <= wilds &&
+            table[mask] < wheelHigh + 1) {
+            table[mask] = wheelHigh + 1;
+        } // endif
+    } // endfor
+} // end function
+
+/**
+ * Function initializeEvaluator
+ * Fills the lookup tables used by the fast evaluator. It must be called
+ * once before any evaluation, and before starting threads that evaluate.
+ *
+ * FORMULAS
+ *  packed << KICKER_BITS | rank
+ *   Appends the next highest rank to the packed ranks, so the highest rank
+ *   always ends in the most significant position.
+ */
+
+void initializeEvaluator() {
+    int mask = 0;
+    int rank = 0;
+
+    fillStraightTable(straightTable, WHEEL_MASK, WHEEL_HIGH, 0);
+    fillStraightTable(shortStraightTable, SHORT_WHEEL_MASK, SHORT_WHEEL_HIGH,
+                      0);
+    for (rank = 0; rank <= MAX_STRAIGHT_WILDS; rank++) {
+        fillStraightTable(wildStraightTables[rank], WHEEL_MASK, WHEEL_HIGH,
+                          rank);
+    } // endfor
+    for (mask = 0; mask < RANK_MASK_AMOUNT; mask++) {
+        unsigned int packed = 0;
+        int found = 0;
+
+        for (rank = CARD_NUMBERS_AMOUNT - 1; rank >= 0; rank--) {
+            if (found < TOP_RANKS_AMOUNT && (mask & (1 << rank))) {
+                packed = (packed << KICKER_BITS) | rank;
+                found++;
+            } // endif
+        } // endfor
+        topRanksTable[mask] = packed << (KICKER_BITS *
+                                         (TOP_RANKS_AMOUNT - found));
+    } // endfor
+    initializeLowTables();
+} // end function
+
+/**
+ * Function getHighRank
+ * Converts a rank to its position when aces are high, TWO being 0 and ACE
+ * being 12.
+ *
+ * @param rank   rank to convert
+ * @return       position of the rank with aces high
+ */
+
+int getHighRank(Rank rank) {
+    return (rank + CARD_NUMBERS_AMOUNT - 1) % CARD_NUMBERS_AMOUNT;
+} // end function
+
+/**
+ * Function getCardMask
+ * Returns the single bit mask representing a card. Each suit owns 13
+ * consecutive bits, ordered from TWO up to ACE.
+ *
+ * @param card   card to convert
+ * @return       mask with only the bit of the card set
+ */
+
+CardMask getCardMask(Card card) {
+    return 1ULL << (card.suit * CARD_NUMBERS_AMOUNT + getHighRank(card.rank));
+} // end function
+
+/**
+ * Function getMaskCard
+ * Returns the card represented by a bit position of a card mask, the
+ * inverse of getCardMask().
+ *
+ * @param bit   bit position, from 0 to DECK_SIZE - 1
+ * @return      card of the bit
+ */
+
+Card getMaskCard(int bit) {
+    Card card = {};
+    card.suit = bit / CARD_NUMBERS_AMOUNT;
+    card.rank = (bit % CARD_NUMBERS_AMOUNT + 1) % CARD_NUMBERS_AMOUNT;
+    return card;
+} // end function
+
+/**
+ * Function cardsToMask
+ * Combines an array of cards into a single card mask.
+ *
+ * @param cards        array of cards to combine
+ * @param cardAmount   amount of cards in the array
+ * @return             mask with one bit set for each card
+ */
+
+CardMask cardsToMask(const Card cards[], int cardAmount) {
+    CardMask mask = 0;
+    int cardIndex = 0;
+
+    for (cardIndex = 0; cardIndex < cardAmount; cardIndex++) {
+        mask |= getCardMask(cards[cardIndex]);
+    } // endfor
+    return mask;
+} // end function
+
+/**
+ * Function topRanks
+ * Returns the highest ranks of a rank mask packed in KICKER_BITS each, with
+ * the highest rank in the most significant position.
+ *
+ * @param mask     rank mask to read the ranks from
+ * @param amount   amount of ranks to keep, from 1 to 5
+ * @return         packed ranks
+ */
+
+static unsigned int topRanks(unsigned int mask, int amount) {
+    return topRanksTable[mask] >> (KICKER_BITS * (TOP_RANKS_AMOUNT - amount));
+} // end function
+
+/**
+ * Function makeValue
+ * Builds a hand value from its poker rank and packed ranks.
+ *
+ * @param rank     poker rank of the hand
+ * @param ranks    packed ranks deciding ties within the poker rank
+ * @return         comparable hand value
+ */
+
+static HandValue makeValue(PokerRank rank, unsigned int ranks) {
+    return ((HandValue) rank << HAND_VALUE_SHIFT) | ranks;
+} // end function
+
+/**
+ * Function evaluateRanks
+ * Evaluates every poker rank below a straight flush from four rank masks,
+ * given the ranks of the flush suit when the hand has a flush. The straight
+ * table and the value class of flushes and full houses are parameters, so
+ * each deck variant gets its own copy of this function once inlined with
+ * constant arguments.
+ *
+ * FORMULAS
+ *  (s0 & s1) | (s0 & s2) | ...
+ *   Ranks present in at least two masks, that is pairs or better. The same
+ *   idea with three masks gives trips or better, and all four gives quads.
+ *
+ *  ranks << (KICKER_BITS * n)
+ *   Places packed ranks below the ranks that define the poker rank, so
+ *   values of the same poker rank compare by their kickers.
+ *
+ * @param rankMasks    array of CARD_TYPE_AMOUNT rank masks
+ * @param flushRanks   ranks of the flush suit, 0 if there is no flush
+ * @param straights    straight table of the deck variant
+ * @param flushClass   value class of a flush
+ * @param fullClass    value class of a full house
+ * @return             comparable hand value
+ */
+
+static inline HandValue evaluateRanks(const unsigned int rankMasks[],
+                                      unsigned int flushRanks,
+                                      const unsigned char straights[],
+                                      PokerRank flushClass,
+                                      PokerRank fullClass) {
+    unsigned int s0 = rankMasks[HEART];
+    unsigned int s1 = rankMasks[DIAMOND];
+    unsigned int s2 = rankMasks[CLUBS];
+    unsigned int s3 = rankMasks[SPADES];
+    unsigned int allRanks = s0 | s1 | s2 | s3;
+    unsigned int pairs = 0;
+    unsigned int trips = 0;
+    unsigned int quads = s0 & s1 & s2 & s3;
+
+    if (quads) {
+        unsigned int quad = topRanks(quads, 1);
+        return makeValue(FOUR_OF_A_KIND, (quad << 16) |
+                         (topRanks(allRanks & ~(1 << quad), 1) << 12));
+    } // endif
+
+    pairs = (s0 & s1) | (s0 & s2) | (s0 & s3) |
+            (s1 & s2) | (s1 & s3) | (s2 & s3);
+    trips = (s0 & s1 & s2) | (s0 & s1 & s3) | (s0 & s2 & s3) | (s1 & s2 & s3);
+    if (flushRanks && flushClass > fullClass) {
+        return makeValue(flushClass, topRanks(flushRanks, 5));
+    } // endif
+    if (trips) {
+        unsigned int trip = topRanks(trips, 1);
+        unsigned int otherPairs = pairs & ~(1 << trip);
+        if (otherPairs) {
+            return makeValue(fullClass, (trip << 16) |
+                             (topRanks(otherPairs, 1) << 12));
+        } // endif
+    } // endif
+    if (flushRanks) {
+        return makeValue(flushClass, topRanks(flushRanks, 5));
+    } // endif
+    if (straights[allRanks]) {
+        return makeValue(STRAIGHT, (straights[allRanks] - 1) << 16);
+    } // endif
+    if (trips) {
+        unsigned int trip = topRanks(trips, 1);
+        return makeValue(THREE_OF_A_KIND, (trip << 16) |
+                         (topRanks(allRanks & ~(1 << trip), 2) << 8));
+    } // endif
+    if (pairs) {
+        unsigned int high = topRanks(pairs, 1);
+        unsigned int lowPairs = pairs & ~(1 << high);
+        if (lowPairs) {
+            unsigned int low = topRanks(lowPairs, 1);
+            unsigned int kickers = allRanks & ~(1 << high) & ~(1 << low);
+            return makeValue(TWO_PAIRS, (high << 16) | (low << 12) |
+                             (topRanks(kickers, 1) << 8));
+        } // endif
+        return makeValue(ONE_PAIR, (high << 16) |
+                         (topRanks(allRanks & ~(1 << high), 3) << 4));
+    } // endif
+    return makeValue(HIGH_CARD, topRanks(allRanks, 5));
+} // end function
+
+/**
+ * Function evaluateSuits
+ * Evaluates a hand given as one rank mask per suit, as returned by the
+ * positions of getHighRank(). The best five cards decide the value, so it
+ * works for any hand from five to seven cards.
+ *
+ * @param suitRanks   array of CARD_TYPE_AMOUNT rank masks
+ * @return            comparable hand value, see getValueRank()
+ */
+
+HandValue evaluateSuits(const unsigned int suitRanks[]) {
+    unsigned int flushRanks = 0;
+    int suit = 0;
+
+    for (suit = 0; suit < CARD_TYPE_AMOUNT; suit++) {
+        if (__builtin_popcount(suitRanks[suit]) >= POKER_HAND_SIZE) {
+            flushRanks = suitRanks[suit];
+        } // endif
+    } // endfor
+    if (flushRanks && straightTable[flushRanks]) {
+        return makeValue(STRAIGHT_FLUSH,
+                         (straightTable[flushRanks] - 1) << 16);
+    } // endif
+    return evaluateRanks(suitRanks, flushRanks, straightTable, FLUSH,
+                         FULL_HOUSE);
+} // end function
+
+/**
+ * Function evaluateNoFlush
+ * Evaluates a hand known not to contain a flush. The masks do not need to
+ * be suits: the n-th mask may hold the ranks appearing at least n + 1 times,
+ * which lets callers evaluate rank patterns without knowing the suits.
+ *
+ * @param rankMasks   array of CARD_TYPE_AMOUNT rank masks
+ * @return            comparable hand value
+ */
+
+HandValue evaluateNoFlush(const unsigned int rankMasks[]) {
+    return evaluateRanks(rankMasks, 0, straightTable, FLUSH, FULL_HOUSE);
+} // end function
+
+/**
+ * Function evaluateShortDeckSuits
+ * Evaluates a short deck (36 cards, SIX to ACE) hand given as one rank mask
+ * per suit. A-6-7-8-9 is the lowest straight, and a flush beats a full
+ * house: flushes get the value class of FULL_HOUSE and full houses the one
+ * of FLUSH, see SHORT_DECK_RANKS to read the poker rank back.
+ *
+ * @param suitRanks   array of CARD_TYPE_AMOUNT rank masks
+ * @return            comparable short deck hand value
+ */
+
+HandValue evaluateShortDeckSuits(const unsigned int suitRanks[]) {
+    unsigned int flushRanks = 0;
+    int suit = 0;
+
+    for (suit = 0; suit < CARD_TYPE_AMOUNT; suit++) {
+        if (__builtin_popcount(suitRanks[suit]) >= POKER_HAND_SIZE) {
+            flushRanks = suitRanks[suit];
+        } // endif
+    } // endfor
+    if (flushRanks && shortStraightTable[flushRanks]) {
+        return makeValue(STRAIGHT_FLUSH,
+                         (shortStraightTable[flushRanks] - 1) << 16);
+    } // endif
+    return evaluateRanks(suitRanks, flushRanks, shortStraightTable,
+                         FULL_HOUSE, FLUSH);
+} // end function
+
+/**
+ * Function reachRanks
+ * Returns the ranks that reach a count with the help of wild cards.
+ *
+ * @param atLeast   atLeast[n]: ranks held at least n times, from 0 to 4
+ * @param count     count to reach
+ * @param wilds     amount of wild cards
+ * @return          rank mask of the ranks reaching the count
+ */
+
+static unsigned int reachRanks(const unsigned int atLeast[], int count,
+                               int wilds) {
+    return atLeast[(count > wilds) ? count - wilds : 0];
+} // end function
+
+/**
+ * Function evaluateWildSuits
+ * Evaluates a hand with wild cards, given as one rank mask per suit of its
+ * natural cards plus the amount of wild cards. A wild card stands for any
+ * card not in the hand, or for a fifth card of a rank to make five of a
+ * kind. Instead of trying substitutions, the best poker rank reachable is
+ * searched from the top: each wild card adds one to a rank count, fills a
+ * missing rank of a straight (see wildStraightTables) or of a flush.
+ *
+ * NOTE: each step only runs when the steps above failed, which bounds the
+ * wild cards left. Two wild cards make quads of any pair and trips of any
+ * card, so a full house, two pairs or a pair with wild cards use one.
+ *
+ * @param suitRanks   array of CARD_TYPE_AMOUNT rank masks of natural cards
+ * @param wilds       amount of wild cards
+ * @return            comparable hand value, see getValueRank()
+ */
+
+HandValue evaluateWildSuits(const unsigned int suitRanks[], int wilds) {
+    unsigned int s0 = suitRanks[HEART];
+    unsigned int s1 = suitRanks[DIAMOND];
+    unsigned int s2 = suitRanks[CLUBS];
+    unsigned int s3 = suitRanks[SPADES];
+    unsigned int atLeast[CARD_TYPE_AMOUNT + 1] = {};
+    const unsigned char *straights = NULL;
+    unsigned int best = 0;
+    unsigned int found = 0;
+    int suit = 0;
+    int wild = 0;
+
+    if (wilds == 0) {
+        return evaluateSuits(suitRanks);
+    } // endif
+    atLeast[0] = SUIT_RANKS_MASK;
+    atLeast[1] = s0 | s1 | s2 | s3;
+    atLeast[2] = (s0 & s1) | (s0 & s2) | (s0 & s3) |
+                 (s1 & s2) | (s1 & s3) | (s2 & s3);
+    atLeast[3] = (s0 & s1 & s2) | (s0 & s1 & s3) | (s0 & s2 & s3) |
+                 (s1 & s2 & s3);
+    atLeast[4] = s0 & s1 & s2 & s3;
+
+    found = reachRanks(atLeast, POKER_HAND_SIZE, wilds);
+    if (found) {
+        return makeValue(FIVE_OF_A_KIND, topRanks(found, 1) << 16);
+    } // endif
+
+    // Five wild cards would have made five of a kind
+    straights = wildStraightTables[wilds];
+    for (suit = 0; suit < CARD_TYPE_AMOUNT; suit++) {
+        if (straights[suitRanks[suit]] > best) {
+            best = straights[suitRanks[suit]];
+        } // endif
+    } // endfor
+    if (best) {
+        return makeValue(STRAIGHT_FLUSH, (best - 1) << 16);
+    } // endif
+
+    found = reachRanks(atLeast, CARD_TYPE_AMOUNT, wilds);
+    if (found) {
+        unsigned int quad = topRanks(found, 1);
+        return makeValue(FOUR_OF_A_KIND, (quad << 16) |
+                         (topRanks(atLeast[1] & ~(1 << quad), 1) << 12));
+    } // endif
+    if (wilds == 1 && __builtin_popcount(atLeast[2]) >= 2) {
+        unsigned int trip = topRanks(atLeast[2], 1);
+        return makeValue(FULL_HOUSE, (trip << 16) |
+                         (topRanks(atLeast[2] & ~(1 << trip), 1) << 12));
+    } // endif
+
+    for (suit = 0; suit < CARD_TYPE_AMOUNT; suit++) {
+        if (__builtin_popcount(suitRanks[suit]) + wilds >= POKER_HAND_SIZE) {
+            unsigned int flushRanks = suitRanks[suit];
+            for (wild = 0; wild < wilds; wild++) {
+                flushRanks |= 1 << (31 - __builtin_clz(~flushRanks &
+                                                       SUIT_RANKS_MASK));
+            } // endfor
+            if (topRanks(flushRanks, 5) > best) {
+                best = topRanks(flushRanks, 5);
+            } // endif
+        } // endif
+    } // endfor
+    if (best) {
+        return makeValue(FLUSH, best);
+    } // endif
+    if (straights[atLeast[1]]) {
+        return makeValue(STRAIGHT, (straights[atLeast[1]] - 1) << 16);
+    } // endif
+
+    found = reachRanks(atLeast, 3, wilds);
+    if (found) {
+        unsigned int trip = topRanks(found, 1);
+        return makeValue(THREE_OF_A_KIND, (trip << 16) |
+                         (topRanks(atLeast[1] & ~(1 << trip), 2) << 8));
+    } // endif
+    found = topRanks(atLeast[1], 1);
+    return makeValue(ONE_PAIR, (found << 16) |
+                     (topRanks(atLeast[1] & ~(1 << found), 3) << 4));
+} // end function
+
+/**
+ * Function evaluateMask
+ * Evaluates a hand given as a card mask.
+ *
+ * FORMULAS
+ *  mask >> (suit * CARD_NUMBERS_AMOUNT)
+ *   Moves the 13 bits of a suit to the bottom of the mask.
+ *
+ * @param mask   card mask of the hand, see getCardMask()
+ * @return       comparable hand value
+ */
+
+HandValue evaluateMask(CardMask mask) {
+    unsigned int suitRanks[CARD_TYPE_AMOUNT] = {};
+    int suit = 0;
+
+    for (suit = 0; suit < CARD_TYPE_AMOUNT; suit++) {
+        suitRanks[suit] = (mask >> (suit * CARD_NUMBERS_AMOUNT)) &
+                          (RANK_MASK_AMOUNT - 1);
+    } // endfor
+    return evaluateSuits(suitRanks);
+} // end function
+
+/**
+ * Function evaluateCards
+ * Evaluates an array of cards in any order.
+ *
+ * @param cards        array of cards to evaluate
+ * @param cardAmount   amount of cards, from 5 to MAX_EVAL_CARDS
+ * @return             comparable hand value
+ */
+
+HandValue evaluateCards(const Card cards[], int cardAmount) {
+    return evaluateMask(cardsToMask(cards, cardAmount));
+} // end function
+
+/**
+ * Function getValueRank
+ * Extracts the poker rank from a hand value.
+ *
+ * @param value   hand value returned by the evaluator
+ * @return        poker rank of the hand
+ */
+
+PokerRank getValueRank(HandValue value) {
+    return value >> HAND_VALUE_SHIFT;
+} // end function
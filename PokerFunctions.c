@@ -80,6 +80,113 @@ PokerRank getWinningRank(const Hand hands[], int players) {
     return currentBestRank;
 } // end function
 
+/**
+ * Function valueHands
+ * Calculates and assigns a comparable value to each hand given by input
+ * array hands, with any high or low evaluator.
+ *
+ * @param hands       array of hands to calculate values from
+ * @param players     amount of players, also the array size
+ * @param evaluator   evaluator calculating the value of five cards
+ */
+
+void valueHands(Hand hands[], int players, ValueEvaluator evaluator) {
+    int playerIndex = 0;
+
+    for (playerIndex = 0; playerIndex < players; playerIndex++) {
+        hands[playerIndex].handValue = evaluator(hands[playerIndex].cards,
+                                                 POKER_HAND_SIZE);
+    } // endfor
+} // end function
+
+/**
+ * Function getWinningValue
+ * Calculates the winning value from an array of hands with their values
+ * already calculated by valueHands().
+ *
+ * @param hands     array of hands to calculate winning value from
+ * @param players   amount of players, also the array's size
+ * @return          winning hand value
+ */
+
+HandValue getWinningValue(const Hand hands[], int players) {
+    HandValue currentBestValue = 0;
+    int playerIndex = 0;
+
+    for (playerIndex = 0; playerIndex < players; playerIndex++) {
+        if (hands[playerIndex].handValue > currentBestValue) {
+            currentBestValue = hands[playerIndex].handValue;
+        } // endif
+    } // endfor
+    return currentBestValue;
+} // end function
+
+/**
+ * Function splitPot
+ * Splits a pot of chips between the best high values and the best low
+ * values. When a player has a qualifying low, the high half gets the odd
+ * chip of the pot; otherwise the high takes the whole pot. Within each
+ * half, chips that do not divide evenly among tied players go one at a
+ * time to the tied players in seat order, starting with the first seat.
+ *
+ * FORMULAS
+ *  pot - pot / 2
+ *   High half of the pot, with the odd chip.
+ *
+ *  half / winners + (winner < half % winners)
+ *   Chips of the winner-th tied player, counted in seat order from 0.
+ *
+ * @param high      high value of each player
+ * @param low       low value of each player, NO_LOW if it does not qualify
+ * @param players   amount of players, also the arrays size
+ * @param pot       chips in the pot
+ * @param shares    array receiving each player's chips
+ */
+
+void splitPot(const HandValue high[], const HandValue low[], int players,
+              long pot, long shares[]) {
+    HandValue bestHigh = 0;
+    HandValue bestLow = NO_LOW;
+    int highWinners = 0;
+    int lowWinners = 0;
+    int highWinner = 0;
+    int lowWinner = 0;
+    long highPot = pot;
+    long lowPot = 0;
+    int playerIndex = 0;
+
+    for (playerIndex = 0; playerIndex < players; playerIndex++) {
+        if (high[playerIndex] > bestHigh) {
+            bestHigh = high[playerIndex];
+        } // endif
+        if (low[playerIndex] > bestLow) {
+            bestLow = low[playerIndex];
+        } // endif
+    } // endfor
+    for (playerIndex = 0; playerIndex < players; playerIndex++) {
+        highWinners += (high[playerIndex] == bestHigh);
+        lowWinners += (bestLow != NO_LOW && low[playerIndex] == bestLow);
+    } // endfor
+    if (lowWinners > 0) {
+        highPot = pot - pot / 2;
+        lowPot = pot / 2;
+    } // endif
+
+    for (playerIndex = 0; playerIndex < players; playerIndex++) {
+        shares[playerIndex] = 0;
+        if (high[playerIndex] == bestHigh) {
+            shares[playerIndex] += highPot / highWinners +
+                                   (highWinner < highPot % highWinners);
+            highWinner++;
+        } // endif
+        if (lowWinners > 0 && low[playerIndex] == bestLow) {
+            shares[playerIndex] += lowPot / lowWinners +
+                                   (lowWinner < lowPot % lowWinners);
+            lowWinner++;
+        } // endif
+    } // endfor
+} // end function
+
 /**
  * Function checkHandFor
  * Helper function to calculate a hand ranking by redirecting to the different
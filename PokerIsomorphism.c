@@ -0,0 +1,505 @@
+
+/*---------------------------------------------------------------------------*\
+
+   Source code:  PokerIsomorphism.c
+        Author:  Marcel Riera
+
+   Description:  Source code containing suit isomorphism functions. Suits
+                 have no order in poker, so any permutation of the suits of
+                 a deal gives identical results for equity, draws or outs.
+                 Card groups (such as hole cards and board) are mapped to a
+                 canonical representative by sorting the suits, which lets
+                 enumerations evaluate each class of deals once, weighted by
+                 its size, and lets result caches share entries between
+                 suit permuted deals.
+
+                 This file is required for compilation of PokerHands.out, and
+                 must be in the same folder with MainCards.c, CardsValidation.c,
+                 CardsFunctions.c, PokerFunctions.c and Cards.h
+
+\*---------------------------------------------------------------------------*/
+
+#include "Cards.h"      // Required program header
+
+#define ISO_LOAD_FACTOR 2       // Slots per expected key
+
+/**
+ * Function getSuitRanks
+ * Returns the 13 rank bits of one suit of a card mask.
+ *
+ * @param mask   card mask to read
+ * @param suit   suit to read
+ * @return       rank mask of the suit
+ */
+
+static unsigned int getSuitRanks(CardMask mask, int suit) {
+    return (mask >> (suit * CARD_NUMBERS_AMOUNT)) & SUIT_RANKS_MASK;
+} // end function
+
+/**
+ * Function canonicalizeGroups
+ * Maps card groups to their canonical suit isomorphic representative. Each
+ * suit gets a signature made of its ranks in every group, the first group
+ * being the most significant, and suits are renamed by decreasing signature.
+ * Suits with equal signatures are interchangeable, so any order between
+ * them gives the same canonical groups.
+ *
+ * FORMULAS
+ *  signature << CARD_NUMBERS_AMOUNT | ranks
+ *   Appends the 13 rank bits of the next group to the signature.
+ *
+ * @param groups         card groups to canonicalize
+ * @param groupAmount    amount of groups, up to ISO_MAX_GROUPS
+ * @param canonical      array receiving the canonical groups
+ * @param permutation    array receiving the canonical suit of each suit
+ */
+
+void canonicalizeGroups(const CardMask groups[], int groupAmount,
+                        CardMask canonical[], int permutation[]) {
+    CardMask signatures[CARD_TYPE_AMOUNT] = {};
+    int order[CARD_TYPE_AMOUNT] = {};
+    int suit = 0;
+    int group = 0;
+    int index = 0;
+
+    for (suit = 0; suit < CARD_TYPE_AMOUNT; suit++) {
+        for (group = 0; group < groupAmount; group++) {
+            signatures[suit] = (signatures[suit] << CARD_NUMBERS_AMOUNT) |
+                               getSuitRanks(groups[group], suit);
+        } // endfor
+
+        // Insertion sort of the suits by decreasing signature
+        for (index = suit; index > 0 &&
+             signatures[order[index - 1]] < signatures[suit]; index--) {
+            order[index] = order[index - 1];
+        } // endfor
+        order[index] = suit;
+    } // endfor
+
+    for (index = 0; index < CARD_TYPE_AMOUNT; index++) {
+        permutation[order[index]] = index;
+    } // endfor
+    for (group = 0; group < groupAmount; group++) {
+        canonical[group] = permuteSuits(groups[group], permutation);
+    } // endfor
+} // end function
+
+/**
+ * Function permuteSuits
+ * Renames the suits of a card mask.
+ *
+ * @param mask          card mask to rename
+ * @param permutation   new suit of each suit
+ * @return              card mask with renamed suits
+ */
+
+CardMask permuteSuits(CardMask mask, const int permutation[]) {
+    CardMask permuted = 0;
+    int suit = 0;
+
+    for (suit = 0; suit < CARD_TYPE_AMOUNT; suit++) {
+        permuted |= (CardMask) getSuitRanks(mask, suit) <<
+                    (permutation[suit] * CARD_NUMBERS_AMOUNT);
+    } // endfor
+    return permuted;
+} // end function
+
+/**
+ * Function hashIsoKey
+ * Calculates the slot of a canonical key in an isomorphism table.
+ *
+ * @param table       table of the key
+ * @param canonical   canonical card groups
+ * @return            first slot to probe
+ */
+
+static long hashIsoKey(const IsoTable *table, const CardMask canonical[]) {
+    unsigned long long hash = 0;
+    int group = 0;
+
+    for (group = 0; group < table->groupAmount; group++) {
+        hash = (hash ^ canonical[group]) * HASH_MULTIPLIER;
+    } // endfor
+    return (long) (hash >> 32) & (table->capacity - 1);
+} // end function
+
+/**
+ * Function isSameKey
+ * Checks whether a table entry holds the given canonical groups.
+ *
+ * @param table       table of the entry
+ * @param entry       entry to compare
+ * @param canonical   canonical card groups
+ * @return            TRUE if equal, FALSE otherwise
+ */
+
+static int isSameKey(const IsoTable *table, const IsoEntry *entry,
+                     const CardMask canonical[]) {
+    int group = 0;
+
+    for (group = 0; group < table->groupAmount; group++) {
+        if (entry->groups[group] != canonical[group]) {
+            return FALSE;
+        } // endif
+    } // endfor
+    return TRUE;
+} // end function
+
+/**
+ * Function createIsoTable
+ * Allocates an empty open addressing table of canonical keys.
+ *
+ * @param table          table to create
+ * @param expectedKeys   largest amount of keys to be added
+ * @param groupAmount    card groups per key, up to ISO_MAX_GROUPS
+ * @return               TRUE if allocated, FALSE otherwise
+ */
+
+int createIsoTable(IsoTable *table, long expectedKeys, int groupAmount) {
+    table->capacity = 1;
+    while (table->capacity < expectedKeys * ISO_LOAD_FACTOR) {
+        table->capacity <<= 1;
+    } // endwhile
+    table->size = 0;
+    table->groupAmount = groupAmount;
+    table->entries = calloc(table->capacity, sizeof(IsoEntry));
+    return (table->entries != NULL);
+} // end function
+
+/**
+ * Function addIsoKey
+ * Adds weight to a canonical key, inserting it when new.
+ * NOTE: the table must have room, as given by createIsoTable().
+ *
+ * @param table       table to add to
+ * @param canonical   canonical card groups
+ * @param weight      weight to add, greater than zero
+ * @return            slot of the key, usable as an index for results
+ */
+
+long addIsoKey(IsoTable *table, const CardMask canonical[], long weight) {
+    long slot = hashIsoKey(table, canonical);
+    int group = 0;
+
+    while (table->entries[slot].weight != 0 &&
+           !isSameKey(table, &table->entries[slot], canonical)) {
+        slot = (slot + 1) & (table->capacity - 1);
+    } // endwhile
+    if (table->entries[slot].weight == 0) {
+        for (group = 0; group < table->groupAmount; group++) {
+            table->entries[slot].groups[group] = canonical[group];
+        } // endfor
+        table->size++;
+    } // endif
+    table->entries[slot].weight += weight;
+    return slot;
+} // end function
+
+/**
+ * Function findIsoKey
+ * Finds the slot of a canonical key.
+ *
+ * @param table       table to search
+ * @param canonical   canonical card groups
+ * @return            slot of the key, or INVALID_INPUT if not present
+ */
+
+long findIsoKey(const IsoTable *table, const CardMask canonical[]) {
+    long slot = hashIsoKey(table, canonical);
+
+    while (table->entries[slot].weight != 0) {
+        if (isSameKey(table, &table->entries[slot], canonical)) {
+            return slot;
+        } // endif
+        slot = (slot + 1) & (table->capacity - 1);
+    } // endwhile
+    return INVALID_INPUT;
+} // end function
+
+/**
+ * Function freeIsoTable
+ * Releases the memory of an isomorphism table.
+ *
+ * @param table   table to release
+ */
+
+void freeIsoTable(IsoTable *table) {
+    free(table->entries);
+    table->entries = NULL;
+    table->capacity = 0;
+    table->size = 0;
+} // end function
+
+/**
+ * Function compareSuits
+ * Compares the fixed signatures of two suits, made of their ranks in every
+ * fixed group, the first group being the most significant.
+ *
+ * @param fixed         known card groups
+ * @param fixedAmount   amount of fixed groups
+ * @param suit          first suit
+ * @param other         second suit
+ * @return              negative, zero or positive as the signature of suit
+ *                      is lower, equal or greater than the one of other
+ */
+
+static int compareSuits(const CardMask fixed[], int fixedAmount, int suit,
+                        int other) {
+    int group = 0;
+
+    for (group = 0; group < fixedAmount; group++) {
+        unsigned int ranks = getSuitRanks(fixed[group], suit);
+        unsigned int otherRanks = getSuitRanks(fixed[group], other);
+        if (ranks != otherRanks) {
+            return (ranks > otherRanks) ? 1 : -1;
+        } // endif
+    } // endfor
+    return 0;
+} // end function
+
+/**
+ * Function initializeSymmetry
+ * Finds the suits that the fixed groups do not tell apart. Suits are
+ * sorted by fixed signature, so that interchangeable suits are adjacent,
+ * and the order is always the same for the same fixed groups.
+ *
+ * @param symmetry      symmetry to fill
+ * @param fixed         known card groups, such as each player's hole cards
+ * @param fixedAmount   amount of fixed groups, any amount
+ */
+
+void initializeSymmetry(SuitSymmetry *symmetry, const CardMask fixed[],
+                        int fixedAmount) {
+    int suit = 0;
+    int index = 0;
+
+    for (suit = 0; suit < CARD_TYPE_AMOUNT; suit++) {
+        for (index = suit; index > 0 && compareSuits(fixed, fixedAmount,
+             symmetry->order[index - 1], suit) < 0; index--) {
+            symmetry->order[index] = symmetry->order[index - 1];
+        } // endfor
+        symmetry->order[index] = suit;
+    } // endfor
+    symmetry->interchangeable[0] = FALSE;
+    for (index = 1; index < CARD_TYPE_AMOUNT; index++) {
+        symmetry->interchangeable[index] = (compareSuits(fixed, fixedAmount,
+            symmetry->order[index - 1], symmetry->order[index]) == 0);
+    } // endfor
+} // end function
+
+/**
+ * Function calcBoardMultiplicity
+ * Calculates the amount of boards in the suit isomorphic class of a
+ * canonical board. Interchangeable suits hold the board ranks in non
+ * increasing order, so the class holds every distinct arrangement of
+ * those rank sets over the interchangeable suits.
+ *
+ * FORMULAS
+ *  k! / (m1! * m2! * ...)
+ *   Arrangements of the rank sets of k interchangeable suits, where m1,
+ *   m2... are the amounts of suits holding equal rank sets.
+ *
+ * @param symmetry     interchangeable suits of the fixed groups
+ * @param suitBoards   board ranks of each suit, in symmetry order
+ * @return             amount of boards of the class
+ */
+
+static long calcBoardMultiplicity(const SuitSymmetry *symmetry,
+                                  const unsigned int suitBoards[]) {
+    long multiplicity = 1;
+    int classSize = 1;
+    int equalSize = 1;
+    int position = 0;
+
+    for (position = 1; position < CARD_TYPE_AMOUNT; position++) {
+        if (!symmetry->interchangeable[position]) {
+            classSize = 1;
+            equalSize = 1;
+        } // endif
+        else {
+            classSize++;
+            equalSize = (suitBoards[position] == suitBoards[position - 1]) ?
+                        equalSize + 1 : 1;
+            multiplicity = multiplicity * classSize / equalSize;
+        } // endelse
+    } // endfor
+    return multiplicity;
+} // end function
+
+/**
+ * Function calcClassWeight
+ * Checks whether a board is the one board of its suit isomorphic class
+ * that addCanonicalBoards() generates, so an enumeration of every board
+ * can deal each class once, weighted by its size, and skip the rest.
+ *
+ * @param symmetry   interchangeable suits of the fixed groups
+ * @param board      board cards, none of them in the fixed groups
+ * @return           amount of boards of its class if canonical, 0 if not
+ */
+
+long calcClassWeight(const SuitSymmetry *symmetry, CardMask board) {
+    unsigned int suitBoards[CARD_TYPE_AMOUNT] = {};
+    int position = 0;
+
+    for (position = 0; position < CARD_TYPE_AMOUNT; position++) {
+        suitBoards[position] = getSuitRanks(board,
+                                            symmetry->order[position]);
+        if (symmetry->interchangeable[position] &&
+            suitBoards[position] > suitBoards[position - 1]) {
+            return 0;
+        } // endif
+    } // endfor
+    return calcBoardMultiplicity(symmetry, suitBoards);
+} // end function
+
+/**
+ * Function addCanonicalBoards
+ * Generates one board of every suit isomorphic class, one suit at a time,
+ * and adds it to the table weighted by its class size. Interchangeable
+ * suits each take a rank set no greater than the previous one, which picks
+ * a single arrangement of every class.
+ *
+ * @param table        table to add to
+ * @param groups       fixed groups followed by room for the board
+ * @param fixedAmount  amount of fixed groups
+ * @param symmetry     interchangeable suits of the fixed groups
+ * @param suitBoards   board ranks of each suit, in symmetry order
+ * @param position     generation position to fill
+ * @param remaining    board cards still to place
+ */
+
+static void addCanonicalBoards(IsoTable *table, CardMask groups[],
+                               int fixedAmount, const SuitSymmetry *symmetry,
+                               unsigned int suitBoards[], int position,
+                               int remaining) {
+    CardMask canonical[ISO_MAX_GROUPS] = {};
+    CardMask dead = 0;
+    int permutation[CARD_TYPE_AMOUNT] = {};
+    int available[CARD_NUMBERS_AMOUNT] = {};
+    int indexes[CARD_NUMBERS_AMOUNT] = {};
+    int suit = 0;
+    int availableAmount = 0;
+    int chosen = 0;
+    int index = 0;
+
+    if (position == CARD_TYPE_AMOUNT) {
+        groups[fixedAmount] = 0;
+        for (index = 0; index < CARD_TYPE_AMOUNT; index++) {
+            groups[fixedAmount] |= (CardMask) suitBoards[index] <<
+                                   (symmetry->order[index] *
+                                    CARD_NUMBERS_AMOUNT);
+        } // endfor
+        canonicalizeGroups(groups, fixedAmount + 1, canonical, permutation);
+        addIsoKey(table, canonical,
+                  calcBoardMultiplicity(symmetry, suitBoards));
+        return;
+    } // endif
+
+    suit = symmetry->order[position];
+    for (index = 0; index < fixedAmount; index++) {
+        dead |= groups[index];
+    } // endfor
+    for (index = 0; index < CARD_NUMBERS_AMOUNT; index++) {
+        if (!(getSuitRanks(dead, suit) & (1U << index))) {
+            available[availableAmount] = index;
+            availableAmount++;
+        } // endif
+    } // endfor
+
+    // The last suit takes every remaining card, the others any amount
+    chosen = (position == CARD_TYPE_AMOUNT - 1) ? remaining : 0;
+    for (; chosen <= remaining && chosen <= availableAmount; chosen++) {
+        firstCombination(indexes, chosen);
+        do {
+            suitBoards[position] = 0;
+            for (index = 0; index < chosen; index++) {
+                suitBoards[position] |= 1U << available[indexes[index]];
+            } // endfor
+            if (!symmetry->interchangeable[position] ||
+                suitBoards[position] <= suitBoards[position - 1]) {
+                addCanonicalBoards(table, groups, fixedAmount, symmetry,
+                                   suitBoards, position + 1,
+                                   remaining - chosen);
+            } // endif
+        } while (nextCombination(indexes, chosen, availableAmount));
+    } // endfor
+} // end function
+
+/**
+ * Function enumerateCanonicalBoards
+ * Enumerates the boards of a given size from the cards not in the fixed
+ * groups, generating one board per suit isomorphic class directly, and adds
+ * each canonical (fixed groups, board) key to a table weighted by the amount
+ * of boards of its class. The board is the last group of each key.
+ *
+ * @param fixed         known card groups, such as each player's hole cards
+ * @param fixedAmount   amount of fixed groups, below ISO_MAX_GROUPS
+ * @param boardAmount   amount of board cards to enumerate
+ * @param table         table to create and fill
+ * @return              TRUE if enumerated, FALSE if out of memory
+ */
+
+int enumerateCanonicalBoards(const CardMask fixed[], int fixedAmount,
+                             int boardAmount, IsoTable *table) {
+    CardMask groups[ISO_MAX_GROUPS] = {};
+    CardMask dead = 0;
+    SuitSymmetry symmetry = {};
+    unsigned int suitBoards[CARD_TYPE_AMOUNT] = {};
+    int index = 0;
+
+    for (index = 0; index < fixedAmount; index++) {
+        groups[index] = fixed[index];
+        dead |= fixed[index];
+    } // endfor
+    initializeSymmetry(&symmetry, fixed, fixedAmount);
+
+    if (!createIsoTable(table, countCombinations(
+            DECK_SIZE - __builtin_popcountll(dead), boardAmount),
+            fixedAmount + 1)) {
+        return FALSE;
+    } // endif
+    addCanonicalBoards(table, groups, fixedAmount, &symmetry, suitBoards, 0,
+                       boardAmount);
+    return TRUE;
+} // end function
+
+/**
+ * Function calcFlopRanks
+ * Calculates the probability of each poker rank on the flop for given hole
+ * cards, evaluating each suit isomorphic class of flops only once.
+ *
+ * @param hole           hole cards, may be empty
+ * @param distribution   array receiving the probability of each PokerRank
+ * @return               amount of canonical flops evaluated, or
+ *                       INVALID_INPUT if out of memory
+ */
+
+long calcFlopRanks(CardMask hole, double distribution[]) {
+    IsoTable table = {};
+    long totalWeight = 0;
+    long slot = 0;
+    long classes = 0;
+    int rank = 0;
+
+    for (rank = HIGH_CARD; rank <= STRAIGHT_FLUSH; rank++) {
+        distribution[rank] = 0;
+    } // endfor
+    if (!enumerateCanonicalBoards(&hole, 1, FLOP_SIZE, &table)) {
+        return INVALID_INPUT;
+    } // endif
+    for (slot = 0; slot < table.capacity; slot++) {
+        const IsoEntry *entry = &table.entries[slot];
+        if (entry->weight != 0) {
+            HandValue value = evaluateMask(entry->groups[0] |
+                                           entry->groups[1]);
+            distribution[getValueRank(value)] += entry->weight;
+            totalWeight += entry->weight;
+        } // endif
+    } // endfor
+    for (rank = HIGH_CARD; rank <= STRAIGHT_FLUSH; rank++) {
+        distribution[rank] /= totalWeight;
+    } // endfor
+    classes = table.size;
+    freeIsoTable(&table);
+    return classes;
+} // end function
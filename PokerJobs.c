@@ -0,0 +1,545 @@
+
+/*---------------------------------------------------------------------------*\
+
+   Source code:  PokerJobs.c
+        Author:  Marcel Riera
+
+   Description:  Source code containing sharded and resumable enumeration
+                 jobs. The exact equity of a Hold'em deal enumerates every
+                 board completing the known cards and, when the last player
+                 holds a random hand, every hole of that player too: one
+                 hand against a random hand before the flop is about 2.1
+                 billion deals. Deals are numbered by hole, then board, in
+                 the lexicographic order of nextCombination(), so a job is
+                 split into shards by index range and any shard runs on its
+                 own, on another process or machine. Suits that no known
+                 card tells apart are interchangeable, so only the one hole
+                 of each suit isomorphic class given by calcClassWeight()
+                 is dealt, and of its boards only the one of each class
+                 once that hole is known, weighted by the size of both
+                 classes; the other holes are skipped whole. Each shard
+                 saves its progress and partial results to a binary result
+                 file every JOB_CHECKPOINT_DEALS deal indexes and resumes
+                 from it when restarted, and result files of different
+                 shards of the same job merge into one by adding their
+                 counters.
+
+                 NOTE: result files are written in the byte order of the
+                 machine, so shards must run on machines of the same kind.
+
+                 This file is required for compilation of PokerHands.out, and
+                 must be in the same folder with MainCards.c, CardsValidation.c,
+                 CardsFunctions.c, PokerFunctions.c and Cards.h
+
+\*---------------------------------------------------------------------------*/
+
+#include "Cards.h"      // Required program header
+
+/**
+ * Function getJobUnseen
+ * Lists the bit positions of the cards not known to a job, in increasing
+ * order, which is the order its boards are numbered in.
+ *
+ * @param job      job to read the known cards from
+ * @param unseen   array of DECK_SIZE bit positions to fill
+ * @return         amount of unseen cards
+ */
+
+static int getJobUnseen(const JobResult *job, int unseen[]) {
+    CardMask known = job->board;
+    int unseenAmount = 0;
+    int player = 0;
+    int bit = 0;
+
+    for (player = 0; player < job->players; player++) {
+        known |= job->holes[player];
+    } // endfor
+    for (bit = 0; bit < DECK_SIZE; bit++) {
+        if (!(known & (1ULL << bit))) {
+            unseen[unseenAmount] = bit;
+            unseenAmount++;
+        } // endif
+    } // endfor
+    return unseenAmount;
+} // end function
+
+/**
+ * Function getJobHoleAmount
+ * Returns the amount of hole cards enumerated by a job.
+ *
+ * @param job   job to read
+ * @return      HOLDEM_HOLE_SIZE with a random hole, 0 otherwise
+ */
+
+static int getJobHoleAmount(const JobResult *job) {
+    return job->randomHole ? HOLDEM_HOLE_SIZE : 0;
+} // end function
+
+/**
+ * Function countJobDeals
+ * Calculates the amount of deals of a whole job.
+ *
+ * FORMULAS
+ *  C(unseen, holeAmount) * C(unseen - holeAmount, missing)
+ *   Every random hole, each with every board from the cards left.
+ *
+ * @param job            job to count
+ * @param unseenAmount   amount of cards not known to the job
+ * @return               amount of deals
+ */
+
+static long long countJobDeals(const JobResult *job, int unseenAmount) {
+    int holeAmount = getJobHoleAmount(job);
+
+    return countCombinations(unseenAmount, holeAmount) *
+           countCombinations(unseenAmount - holeAmount,
+                             BOARD_SIZE - job->boardAmount);
+} // end function
+
+/**
+ * Function initializeJobSymmetry
+ * Finds the suits interchangeable for a job given the hole cards of every
+ * player and the known board.
+ *
+ * @param job        job to read the players and the board from
+ * @param holes      hole cards of each player, 0 for a random hole
+ * @param symmetry   symmetry to fill
+ */
+
+static void initializeJobSymmetry(const JobResult *job,
+                                  const CardMask holes[],
+                                  SuitSymmetry *symmetry) {
+    CardMask fixed[MAX_PLAYERS + 1] = {};
+    int player = 0;
+
+    for (player = 0; player < job->players; player++) {
+        fixed[player] = holes[player];
+    } // endfor
+    fixed[job->players] = job->board;
+    initializeSymmetry(symmetry, fixed, job->players + 1);
+} // end function
+
+/**
+ * Function dealJobHole
+ * Sets the hole cards of every player for one random hole combination,
+ * lists the unseen cards left for the board and finds the suits still
+ * interchangeable for its boards.
+ *
+ * @param job             job to deal
+ * @param holeSymmetry    interchangeable suits of the known cards
+ * @param unseen          bit positions of the cards not known to the job
+ * @param unseenAmount    amount of unseen cards
+ * @param holeIndexes     indexes in unseen of the random hole cards
+ * @param holes           array receiving the hole cards of each player
+ * @param boardUnseen     array receiving the bit positions left for boards
+ * @param boardSymmetry   symmetry receiving the interchangeable suits of
+ *                        the boards, only set for a canonical hole
+ * @return                amount of holes of the class of the random hole
+ *                        if canonical, 0 if not, 1 without a random hole
+ */
+
+static long dealJobHole(const JobResult *job,
+                        const SuitSymmetry *holeSymmetry, const int unseen[],
+                        int unseenAmount, const int holeIndexes[],
+                        CardMask holes[], int boardUnseen[],
+                        SuitSymmetry *boardSymmetry) {
+    CardMask randomHole = 0;
+    long holeWeight = 1;
+    int boardUnseenAmount = 0;
+    int player = 0;
+    int index = 0;
+
+    for (index = 0; index < getJobHoleAmount(job); index++) {
+        randomHole |= 1ULL << unseen[holeIndexes[index]];
+    } // endfor
+    if (job->randomHole) {
+        holeWeight = calcClassWeight(holeSymmetry, randomHole);
+        if (holeWeight == 0) {
+            return 0;   // Dealt with the canonical hole of its class
+        } // endif
+    } // endif
+
+    for (player = 0; player < job->players; player++) {
+        holes[player] = job->holes[player];
+    } // endfor
+    holes[job->players - 1] |= randomHole;
+    for (index = 0; index < unseenAmount; index++) {
+        if (!(randomHole & (1ULL << unseen[index]))) {
+            boardUnseen[boardUnseenAmount] = unseen[index];
+            boardUnseenAmount++;
+        } // endif
+    } // endfor
+    initializeJobSymmetry(job, holes, boardSymmetry);
+    return holeWeight;
+} // end function
+
+/**
+ * Function addJobShares
+ * Evaluates one deal of a job and adds each winner's share of the pot,
+ * times the amount of deals of its class.
+ *
+ * @param job      job to add to
+ * @param holes    hole cards of each player
+ * @param board    complete board
+ * @param weight   amount of deals of the class of the deal
+ */
+
+static void addJobShares(JobResult *job, const CardMask holes[],
+                         CardMask board, long weight) {
+    HandValue values[MAX_PLAYERS] = {};
+    HandValue bestValue = 0;
+    int winners = 0;
+    int player = 0;
+
+    for (player = 0; player < job->players; player++) {
+        values[player] = evaluateMask(board | holes[player]);
+        if (values[player] > bestValue) {
+            bestValue = values[player];
+            winners = 0;
+        } // endif
+        winners += (values[player] == bestValue);
+    } // endfor
+    for (player = 0; player < job->players; player++) {
+        if (values[player] == bestValue) {
+            job->shares[player] += JOB_POT_UNITS / winners * weight;
+        } // endif
+    } // endfor
+    job->deals += weight;
+} // end function
+
+/**
+ * Function isValidJob
+ * Checks that a job read from a file is one this program could have
+ * written, so a damaged or foreign file is never enumerated.
+ *
+ * FORMULAS
+ *  shardMask >> shards
+ *   Bits of shards past the amount of shards, which must be none.
+ *
+ * @param job   job to check
+ * @return      TRUE if valid, FALSE otherwise
+ */
+
+static int isValidJob(const JobResult *job) {
+    int unseen[DECK_SIZE] = {};
+    CardMask known = job->board;
+    int knownHoles = 0;
+    int player = 0;
+
+    if (job->magic != JOB_MAGIC || job->players < 2 ||
+        job->players > MAX_PLAYERS || job->boardAmount < 0 ||
+        job->boardAmount > BOARD_SIZE || job->shards < 1 ||
+        job->shards > MAX_SHARDS || job->shardMask == 0 ||
+        (job->shards < MAX_SHARDS && (job->shardMask >> job->shards)) ||
+        (job->randomHole != FALSE && job->randomHole != TRUE)) {
+        return FALSE;
+    } // endif
+    knownHoles = job->players - job->randomHole;
+    for (player = 0; player < job->players; player++) {
+        if (player >= knownHoles && job->holes[player] != 0) {
+            return FALSE;
+        } // endif
+        known |= job->holes[player];
+    } // endfor
+    if ((known & ~FULL_DECK_MASK) || __builtin_popcountll(known) !=
+        knownHoles * HOLDEM_HOLE_SIZE + job->boardAmount) {
+        return FALSE;
+    } // endif
+    return (job->next >= 0 && job->next <= job->end && job->deals >= 0 &&
+            job->end <= countJobDeals(job, getJobUnseen(job, unseen)));
+} // end function
+
+/**
+ * Function initializeJob
+ * Prepares a shard of the exact equity job of a Hold'em deal, with the
+ * deals of the shard still to be dealt. With a random hole the last
+ * player's hole cards are enumerated too, and holes gives one player less.
+ *
+ * FORMULAS
+ *  deals * shard / shards
+ *   First deal index of a shard, so the shards split the deals evenly
+ *   and the end of a shard is the start of the next one.
+ *
+ * @param job           job to prepare
+ * @param holes         HOLDEM_HOLE_SIZE hole cards per known player, one
+ *                      player after the other
+ * @param players       amount of players, from 2 to MAX_PLAYERS
+ * @param randomHole    TRUE to enumerate the last player's hole cards
+ * @param board         known board cards
+ * @param boardAmount   amount of known board cards, up to BOARD_SIZE
+ * @param shard         shard to run, from 0 to shards - 1
+ * @param shards        amount of shards, up to MAX_SHARDS
+ * @return              VALID_INPUT, or INVALID_INPUT for an invalid job
+ */
+
+int initializeJob(JobResult *job, const Card holes[], int players,
+                  int randomHole, const Card board[], int boardAmount,
+                  int shard, int shards) {
+    int unseen[DECK_SIZE] = {};
+    long long deals = 0;
+    CardMask known = 0;
+    int knownHoles = players - (randomHole ? 1 : 0);
+    int player = 0;
+
+    if (players < 2 || players > MAX_PLAYERS || boardAmount < 0 ||
+        boardAmount > BOARD_SIZE || shards < 1 || shards > MAX_SHARDS ||
+        shard < 0 || shard >= shards) {
+        return INVALID_INPUT;
+    } // endif
+    job->magic = JOB_MAGIC;
+    job->players = players;
+    job->boardAmount = boardAmount;
+    job->shards = shards;
+    job->randomHole = randomHole ? TRUE : FALSE;
+    job->board = cardsToMask(board, boardAmount);
+    known = job->board;
+    for (player = 0; player < MAX_PLAYERS; player++) {
+        job->holes[player] = 0;
+        job->shares[player] = 0;
+    } // endfor
+    for (player = 0; player < knownHoles; player++) {
+        job->holes[player] = cardsToMask(holes + (player * HOLDEM_HOLE_SIZE),
+                                         HOLDEM_HOLE_SIZE);
+        known |= job->holes[player];
+    } // endfor
+    if (__builtin_popcountll(known) !=
+        knownHoles * HOLDEM_HOLE_SIZE + boardAmount) {
+        return INVALID_INPUT;   // Repeated cards
+    } // endif
+
+    deals = countJobDeals(job, getJobUnseen(job, unseen));
+    job->shardMask = 1ULL << shard;
+    job->next = deals * shard / shards;
+    job->end = deals * (shard + 1) / shards;
+    job->deals = 0;
+    return VALID_INPUT;
+} // end function
+
+/**
+ * Function loadJob
+ * Reads a result file, rejecting it unless it holds a valid job, see
+ * isValidJob().
+ *
+ * @param path   path of the result file
+ * @param job    job receiving the file contents
+ * @return       VALID_INPUT, or INVALID_INPUT if missing or not a result
+ */
+
+int loadJob(const char *path, JobResult *job) {
+    FILE *file = fopen(path, "rb");
+    int valid = FALSE;
+
+    if (file == NULL) {
+        return INVALID_INPUT;
+    } // endif
+    valid = (fread(job, sizeof(JobResult), 1, file) == 1 &&
+             isValidJob(job));
+    fclose(file);
+    return valid ? VALID_INPUT : INVALID_INPUT;
+} // end function
+
+/**
+ * Function saveJob
+ * Writes a result file through a temporary file renamed over the previous
+ * one, so an interruption never leaves a partly written checkpoint.
+ *
+ * @param path   path of the result file
+ * @param job    job to write
+ * @return       VALID_INPUT, or INVALID_INPUT if it could not be written
+ */
+
+int saveJob(const char *path, const JobResult *job) {
+    char temporary[JOB_PATH_LEN] = {};
+    FILE *file = NULL;
+    int written = FALSE;
+
+    if (snprintf(temporary, JOB_PATH_LEN, "%s.tmp", path) >= JOB_PATH_LEN) {
+        return INVALID_INPUT;
+    } // endif
+    file = fopen(temporary, "wb");
+    if (file == NULL) {
+        return INVALID_INPUT;
+    } // endif
+    written = (fwrite(job, sizeof(JobResult), 1, file) == 1);
+    written &= (fclose(file) == 0);
+    if (!written || rename(temporary, path) != 0) {
+        return INVALID_INPUT;
+    } // endif
+    return VALID_INPUT;
+} // end function
+
+/**
+ * Function isSameJob
+ * Checks whether two result files belong to the same job, whatever their
+ * shards.
+ *
+ * @param job     first job
+ * @param other   second job
+ * @return        TRUE if same deal and amount of shards, FALSE otherwise
+ */
+
+int isSameJob(const JobResult *job, const JobResult *other) {
+    int player = 0;
+
+    if (job->players != other->players || job->shards != other->shards ||
+        job->boardAmount != other->boardAmount ||
+        job->randomHole != other->randomHole || job->board != other->board) {
+        return FALSE;
+    } // endif
+    for (player = 0; player < job->players; player++) {
+        if (job->holes[player] != other->holes[player]) {
+            return FALSE;
+        } // endif
+    } // endfor
+    return TRUE;
+} // end function
+
+/**
+ * Function runJobShard
+ * Deals the remaining deals of a shard, adding each player's share of
+ * every pot for the canonical deals, weighted by the size of their class,
+ * and saves a checkpoint every JOB_CHECKPOINT_DEALS deal indexes and when
+ * done. A job loaded from its result file resumes where it stopped.
+ *
+ * FORMULAS
+ *  next / boards and next % boards
+ *   Random hole and board combinations of a deal index.
+ *  next + boards - next % boards
+ *   First deal index of the next random hole.
+ *
+ * @param path   path of the result file
+ * @param job    shard to run, see initializeJob()
+ * @return       VALID_INPUT, or INVALID_INPUT if a checkpoint failed
+ */
+
+int runJobShard(const char *path, JobResult *job) {
+    SuitSymmetry holeSymmetry = {};
+    SuitSymmetry boardSymmetry = {};
+    int unseen[DECK_SIZE] = {};
+    int boardUnseen[DECK_SIZE] = {};
+    int holeIndexes[HOLDEM_HOLE_SIZE] = {};
+    int indexes[BOARD_SIZE] = {};
+    CardMask holes[MAX_PLAYERS] = {};
+    int missing = BOARD_SIZE - job->boardAmount;
+    int unseenAmount = getJobUnseen(job, unseen);
+    int holeAmount = getJobHoleAmount(job);
+    int boardUnseenAmount = unseenAmount - holeAmount;
+    long long boards = countCombinations(boardUnseenAmount, missing);
+    long holeWeight = 0;
+    int lastBoard = FALSE;
+    int index = 0;
+
+    initializeJobSymmetry(job, job->holes, &holeSymmetry);
+    while (job->next < job->end) {
+        long long stop = job->next + JOB_CHECKPOINT_DEALS;
+        if (stop > job->end) {
+            stop = job->end;
+        } // endif
+
+        unrankCombination(job->next / boards, holeIndexes, holeAmount,
+                          unseenAmount);
+        unrankCombination(job->next % boards, indexes, missing,
+                          boardUnseenAmount);
+        holeWeight = dealJobHole(job, &holeSymmetry, unseen, unseenAmount,
+                                 holeIndexes, holes, boardUnseen,
+                                 &boardSymmetry);
+        while (job->next < stop) {
+            if (holeWeight == 0) {
+                job->next += boards - job->next % boards;
+                if (job->next > stop) {
+                    job->next = stop;
+                } // endif
+                lastBoard = TRUE;
+            } // endif
+            else {
+                CardMask dealt = 0;
+                long weight = 0;
+                for (index = 0; index < missing; index++) {
+                    dealt |= 1ULL << boardUnseen[indexes[index]];
+                } // endfor
+                weight = calcClassWeight(&boardSymmetry, dealt);
+                if (weight != 0) {
+                    addJobShares(job, holes, job->board | dealt,
+                                 holeWeight * weight);
+                } // endif
+                job->next++;
+                lastBoard = !nextCombination(indexes, missing,
+                                             boardUnseenAmount);
+            } // endelse
+
+            // After the last board of a random hole comes the next hole
+            if (lastBoard) {
+                firstCombination(indexes, missing);
+                nextCombination(holeIndexes, holeAmount, unseenAmount);
+                holeWeight = dealJobHole(job, &holeSymmetry, unseen,
+                                         unseenAmount, holeIndexes, holes,
+                                         boardUnseen, &boardSymmetry);
+            } // endif
+        } // endwhile
+        if (saveJob(path, job) == INVALID_INPUT) {
+            return INVALID_INPUT;
+        } // endif
+    } // endwhile
+    return VALID_INPUT;
+} // end function
+
+/**
+ * Function mergeJobs
+ * Adds the results of a finished shard, or of merged shards, to a merged
+ * result. An empty merged result (magic 0) takes the part as it is.
+ *
+ * @param merged   merged result to add to
+ * @param part     result to add, of the same job and other shards
+ * @return         VALID_INPUT, or INVALID_INPUT if they do not merge
+ */
+
+int mergeJobs(JobResult *merged, const JobResult *part) {
+    int player = 0;
+
+    if (part->next != part->end) {
+        return INVALID_INPUT;   // Unfinished shard
+    } // endif
+    if (merged->magic != JOB_MAGIC) {
+        *merged = *part;
+        return VALID_INPUT;
+    } // endif
+    if (!isSameJob(merged, part) || (merged->shardMask & part->shardMask)) {
+        return INVALID_INPUT;
+    } // endif
+    merged->shardMask |= part->shardMask;
+    merged->deals += part->deals;
+    for (player = 0; player < merged->players; player++) {
+        merged->shares[player] += part->shares[player];
+    } // endfor
+    return VALID_INPUT;
+} // end function
+
+/**
+ * Function displayJob
+ * Displays the progress of a result file and the equity of every player
+ * over the boards dealt so far, which is exact once every shard is in.
+ * Deals dealt count every deal of the classes dealt so far.
+ *
+ * @param job   job to display
+ */
+
+void displayJob(const JobResult *job) {
+    int player = 0;
+
+    for (player = 0; player < job->players; player++) {
+        double equity = 0;
+        if (job->deals > 0) {
+            equity = (double) job->shares[player] /
+                     ((double) job->deals * JOB_POT_UNITS);
+        } // endif
+        wprintf(L"Player  %d] - equity %8.4f%%%ls\n", player + 1,
+                equity * 100, (job->randomHole && player == job->players - 1)
+                ? L" (random hand)" : L"");
+    } // endfor
+    wprintf(L"%lld deals dealt, %d of %d shards", job->deals,
+            __builtin_popcountll(job->shardMask), job->shards);
+    if (job->next != job->end) {
+        wprintf(L", %lld deals left in this shard", job->end - job->next);
+    } // endif
+    wprintf(L"\n");
+} // end function
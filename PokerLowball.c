@@ -0,0 +1,391 @@
+
+/*---------------------------------------------------------------------------*\
+
+   Source code:  PokerLowball.c
+        Author:  Marcel Riera
+
+   Description:  Source code containing table driven low hand evaluators for
+                 ace to five lowball, eight or better split pots (also for
+                 Omaha hi-lo) and deuce to seven lowball.
+
+                 Low evaluators return a HandValue where a higher value is a
+                 better low, so they share the batch and showdown functions
+                 of the high evaluator. A low value is LOW_VALUE_LIMIT minus
+                 the value of the hand when judged as a high hand under the
+                 rules of the low game, and NO_LOW for hands that do not
+                 qualify.
+
+                 This file is required for compilation of PokerHands.out, and
+                 must be in the same folder with MainCards.c, CardsValidation.c,
+                 CardsFunctions.c, PokerFunctions.c and Cards.h
+
+\*---------------------------------------------------------------------------*/
+
+#include "Cards.h"      // Required program header
+
+#define LOW_RANKS_AMOUNT 5      // Ranks forming a low hand
+#define NO_STRAIGHT -1          // Mask is not a deuce to seven straight
+#define FIVE_IN_A_ROW 0x1F      // Five consecutive ranks at the bottom
+
+static unsigned int lowRanksTable[RANK_MASK_AMOUNT];  // Packed lowest 5 ranks
+static unsigned int highRanksTable[RANK_MASK_AMOUNT]; // Packed highest 5 ranks
+static signed char deuceStraightTable[RANK_MASK_AMOUNT]; // Straight high rank
+static unsigned short deuceLowTable[RANK_MASK_AMOUNT]; // Best 5 rank low mask
+
+/**
+ * Function fillDeuceLow
+ * Fills the deuce to seven table entry of a rank mask with its five ranks
+ * making the best low that is not a straight, or 0 if there are none. It
+ * needs highRanksTable and deuceStraightTable filled for every mask.
+ *
+ * FORMULAS
+ *  subset = (subset - 1) & mask
+ *   Visits every subset of the mask, from the mask itself down to 0.
+ *
+ * @param mask   rank mask, aces high as laid out by getHighRank()
+ */
+
+static void fillDeuceLow(int mask) {
+    int subset = 0;
+
+    deuceLowTable[mask] = 0;
+    for (subset = mask; subset > 0; subset = (subset - 1) & mask) {
+        if (__builtin_popcount(subset) == LOW_RANKS_AMOUNT &&
+            deuceStraightTable[subset] == NO_STRAIGHT &&
+            (deuceLowTable[mask] == 0 ||
+             highRanksTable[subset] < highRanksTable[deuceLowTable[mask]])) {
+            deuceLowTable[mask] = subset;
+        } // endif
+    } // endfor
+} // end function
+
+/**
+ * Function initializeLowTables
+ * Fills the lookup tables of the low evaluators. Called by
+ * initializeEvaluator().
+ *
+ * FORMULAS
+ *  packed | rank << (KICKER_BITS * found)
+ *   Ranks are read from the lowest up, so each new rank is placed above the
+ *   previous ones and the highest of the five ends in the most significant
+ *   position, as in every other hand value.
+ */
+
+void initializeLowTables() {
+    int mask = 0;
+    int rank = 0;
+
+    for (mask = 0; mask < RANK_MASK_AMOUNT; mask++) {
+        unsigned int lowPacked = 0;
+        unsigned int highPacked = 0;
+        int lowFound = 0;
+        int highFound = 0;
+
+        for (rank = 0; rank < CARD_NUMBERS_AMOUNT; rank++) {
+            if (lowFound < LOW_RANKS_AMOUNT && (mask & (1 << rank))) {
+                lowPacked |= rank << (KICKER_BITS * lowFound);
+                lowFound++;
+            } // endif
+        } // endfor
+        for (rank = CARD_NUMBERS_AMOUNT - 1; rank >= 0; rank--) {
+            if (highFound < LOW_RANKS_AMOUNT && (mask & (1 << rank))) {
+                highPacked = (highPacked << KICKER_BITS) | rank;
+                highFound++;
+            } // endif
+        } // endfor
+        lowRanksTable[mask] = lowPacked;
+        highRanksTable[mask] = highPacked;
+
+        // Five consecutive ranks with aces high only, the wheel is no straight
+        deuceStraightTable[mask] = NO_STRAIGHT;
+        if (__builtin_popcount(mask) == LOW_RANKS_AMOUNT &&
+            (mask >> __builtin_ctz(mask)) == FIVE_IN_A_ROW) {
+            deuceStraightTable[mask] = 31 - __builtin_clz(mask);
+        } // endif
+    } // endfor
+    for (mask = 0; mask < RANK_MASK_AMOUNT; mask++) {
+        fillDeuceLow(mask);
+    } // endfor
+} // end function
+
+/**
+ * Function getLowRankMasks
+ * Builds rank masks for a hand where the n-th mask holds the ranks appearing
+ * more than n times, with ranks in Rank order so the ACE is the lowest.
+ *
+ * @param cards        cards of the hand
+ * @param cardAmount   amount of cards
+ * @param rankMasks    array of CARD_TYPE_AMOUNT masks to fill
+ */
+
+static void getLowRankMasks(const Card cards[], int cardAmount,
+                            unsigned int rankMasks[]) {
+    int cardIndex = 0;
+    int count = 0;
+
+    for (count = 0; count < CARD_TYPE_AMOUNT; count++) {
+        rankMasks[count] = 0;
+    } // endfor
+    for (cardIndex = 0; cardIndex < cardAmount; cardIndex++) {
+        unsigned int bit = 1 << cards[cardIndex].rank;
+        count = 0;
+        while (rankMasks[count] & bit) {
+            count++;
+        } // endwhile
+        rankMasks[count] |= bit;
+    } // endfor
+} // end function
+
+/**
+ * Function toLowValue
+ * Inverts the value of a hand judged as a high hand, so better lows get
+ * higher values.
+ *
+ * @param badness   value of the hand as a high hand
+ * @return          comparable low value
+ */
+
+static HandValue toLowValue(HandValue badness) {
+    return LOW_VALUE_LIMIT - badness;
+} // end function
+
+/**
+ * Function evaluateAceToFive
+ * Calculates the best ace to five low of five to seven cards. Aces are low,
+ * and straights and flushes do not count. With five different ranks the
+ * lowest five are always best, read from the table; otherwise every five
+ * card combination has a pair and is judged by its rank pattern only.
+ *
+ * @param cards        cards of the hand
+ * @param cardAmount   amount of cards, from 5 to MAX_EVAL_CARDS
+ * @return             comparable low value
+ */
+
+HandValue evaluateAceToFive(const Card cards[], int cardAmount) {
+    unsigned int rankMasks[CARD_TYPE_AMOUNT] = {};
+    HandValue bestBadness = LOW_VALUE_LIMIT;
+    int indexes[POKER_HAND_SIZE] = {};
+    int handIndex = 0;
+
+    getLowRankMasks(cards, cardAmount, rankMasks);
+    if (__builtin_popcount(rankMasks[0]) >= LOW_RANKS_AMOUNT) {
+        return toLowValue(lowRanksTable[rankMasks[0]]);
+    } // endif
+
+    // Fewer than five ranks: every combination has a pair, so no straight
+    firstCombination(indexes, POKER_HAND_SIZE);
+    do {
+        Card hand[POKER_HAND_SIZE] = {};
+        HandValue badness = 0;
+
+        for (handIndex = 0; handIndex < POKER_HAND_SIZE; handIndex++) {
+            hand[handIndex] = cards[indexes[handIndex]];
+        } // endfor
+        getLowRankMasks(hand, POKER_HAND_SIZE, rankMasks);
+        badness = evaluateNoFlush(rankMasks);
+        if (badness < bestBadness) {
+            bestBadness = badness;
+        } // endif
+    } while (nextCombination(indexes, POKER_HAND_SIZE, cardAmount));
+    return toLowValue(bestBadness);
+} // end function
+
+/**
+ * Function evaluateEightOrBetter
+ * Calculates the qualifying low of five to seven cards for split pot games:
+ * five different ranks from ACE to EIGHT, judged as ace to five.
+ *
+ * @param cards        cards of the hand
+ * @param cardAmount   amount of cards, from 5 to MAX_EVAL_CARDS
+ * @return             comparable low value, NO_LOW if it does not qualify
+ */
+
+HandValue evaluateEightOrBetter(const Card cards[], int cardAmount) {
+    unsigned int lowRanks = 0;
+    int cardIndex = 0;
+
+    for (cardIndex = 0; cardIndex < cardAmount; cardIndex++) {
+        lowRanks |= 1 << cards[cardIndex].rank;
+    } // endfor
+    lowRanks &= LOW_QUALIFIER_MASK;
+    if (__builtin_popcount(lowRanks) < LOW_RANKS_AMOUNT) {
+        return NO_LOW;
+    } // endif
+    return toLowValue(lowRanksTable[lowRanks]);
+} // end function
+
+/**
+ * Function calcDeuceToSevenBadness
+ * Calculates the value of exactly five cards as a high hand under deuce to
+ * seven rules: aces are always high, and straights and flushes count, but
+ * A-2-3-4-5 is not a straight.
+ *
+ * @param cards   five cards of the hand
+ * @return        value of the hand as a high hand
+ */
+
+static HandValue calcDeuceToSevenBadness(const Card cards[]) {
+    unsigned int suitRanks[CARD_TYPE_AMOUNT] = {};
+    unsigned int allRanks = 0;
+    int flush = TRUE;
+    int cardIndex = 0;
+    int straightHigh = 0;
+    PokerRank rank = HIGH_CARD;
+
+    for (cardIndex = 0; cardIndex < POKER_HAND_SIZE; cardIndex++) {
+        suitRanks[cards[cardIndex].suit] |= 1 << getHighRank(
+                                                 cards[cardIndex].rank);
+        flush &= (cards[cardIndex].suit == cards[FIRST_CARD].suit);
+    } // endfor
+    allRanks = suitRanks[HEART] | suitRanks[DIAMOND] |
+               suitRanks[CLUBS] | suitRanks[SPADES];
+    if (__builtin_popcount(allRanks) < POKER_HAND_SIZE) {
+        return evaluateNoFlush(suitRanks);
+    } // endif
+
+    straightHigh = deuceStraightTable[allRanks];
+    if (straightHigh != NO_STRAIGHT) {
+        rank = flush ? STRAIGHT_FLUSH : STRAIGHT;
+        return ((HandValue) rank << HAND_VALUE_SHIFT) |
+               (straightHigh << 16);
+    } // endif
+    rank = flush ? FLUSH : HIGH_CARD;
+    return ((HandValue) rank << HAND_VALUE_SHIFT) | highRanksTable[allRanks];
+} // end function
+
+/**
+ * Function isForcedFlush
+ * Checks whether five different ranks can only be taken from one suit, so
+ * any five cards of those ranks are a flush.
+ *
+ * @param ranks       mask of five ranks, aces high
+ * @param suitRanks   array of CARD_TYPE_AMOUNT rank masks of the hand
+ * @return            TRUE if the ranks only make a flush, FALSE otherwise
+ */
+
+static int isForcedFlush(unsigned int ranks, const unsigned int suitRanks[]) {
+    int suit = 0;
+    int other = 0;
+
+    for (suit = 0; suit < CARD_TYPE_AMOUNT; suit++) {
+        unsigned int others = 0;
+        for (other = 0; other < CARD_TYPE_AMOUNT; other++) {
+            if (other != suit) {
+                others |= suitRanks[other];
+            } // endif
+        } // endfor
+        if ((ranks & suitRanks[suit]) == ranks && !(ranks & others)) {
+            return TRUE;
+        } // endif
+    } // endfor
+    return FALSE;
+} // end function
+
+/**
+ * Function evaluateDeuceToSeven
+ * Calculates the best deuce to seven low of five to seven cards. With five
+ * different ranks the best low is usually the lowest five ranks that are
+ * not a straight, read from the table, unless those ranks only come in one
+ * suit. Otherwise every five card combination is judged as a high hand,
+ * keeping the lowest, as paired hands and the rare forced straights or
+ * flushes need whole combinations.
+ *
+ * @param cards        cards of the hand
+ * @param cardAmount   amount of cards, from 5 to MAX_EVAL_CARDS
+ * @return             comparable low value
+ */
+
+HandValue evaluateDeuceToSeven(const Card cards[], int cardAmount) {
+    unsigned int suitRanks[CARD_TYPE_AMOUNT] = {};
+    HandValue bestBadness = LOW_VALUE_LIMIT;
+    int indexes[POKER_HAND_SIZE] = {};
+    unsigned int lowRanks = 0;
+    int handIndex = 0;
+
+    for (handIndex = 0; handIndex < cardAmount; handIndex++) {
+        suitRanks[cards[handIndex].suit] |= 1 << getHighRank(
+                                                 cards[handIndex].rank);
+    } // endfor
+    lowRanks = deuceLowTable[suitRanks[HEART] | suitRanks[DIAMOND] |
+                             suitRanks[CLUBS] | suitRanks[SPADES]];
+    if (lowRanks != 0 && !isForcedFlush(lowRanks, suitRanks)) {
+        return toLowValue(highRanksTable[lowRanks]);
+    } // endif
+
+    firstCombination(indexes, POKER_HAND_SIZE);
+    do {
+        Card hand[POKER_HAND_SIZE] = {};
+        HandValue badness = 0;
+
+        for (handIndex = 0; handIndex < POKER_HAND_SIZE; handIndex++) {
+            hand[handIndex] = cards[indexes[handIndex]];
+        } // endfor
+        badness = calcDeuceToSevenBadness(hand);
+        if (badness < bestBadness) {
+            bestBadness = badness;
+        } // endif
+    } while (nextCombination(indexes, POKER_HAND_SIZE, cardAmount));
+    return toLowValue(bestBadness);
+} // end function
+
+/**
+ * Function evaluateOmahaLow
+ * Calculates the eight or better low of an Omaha hand, which must use two
+ * hole cards and three board cards. A combination qualifies only when the
+ * two hole ranks and the three board ranks are five different ranks from
+ * ACE to EIGHT, so whole combinations are tested as rank masks.
+ *
+ * @param hole          hole cards of the player
+ * @param holeAmount    OMAHA_HOLE_SIZE or PLO5_HOLE_SIZE
+ * @param board         board cards
+ * @param boardAmount   amount of board cards, from FLOP_SIZE to BOARD_SIZE
+ * @return              comparable low value, NO_LOW if it does not qualify
+ */
+
+HandValue evaluateOmahaLow(const Card hole[], int holeAmount,
+                           const Card board[], int boardAmount) {
+    unsigned int tripleRanks[MAX_BOARD_TRIPLES] = {};
+    int tripleAmount = 0;
+    HandValue bestValue = NO_LOW;
+    int i = 0, j = 0, k = 0;
+    int tripleIndex = 0;
+
+    for (i = 0; i < boardAmount; i++) {
+        for (j = i + 1; j < boardAmount; j++) {
+            for (k = j + 1; k < boardAmount; k++) {
+                unsigned int ranks = (1 << board[i].rank) |
+                                     (1 << board[j].rank) |
+                                     (1 << board[k].rank);
+                if ((ranks & LOW_QUALIFIER_MASK) == ranks &&
+                    __builtin_popcount(ranks) == OMAHA_BOARD_USED) {
+                    tripleRanks[tripleAmount] = ranks;
+                    tripleAmount++;
+                } // endif
+            } // endfor
+        } // endfor
+    } // endfor
+    if (tripleAmount == 0) {
+        return NO_LOW;
+    } // endif
+
+    for (i = 0; i < holeAmount; i++) {
+        for (j = i + 1; j < holeAmount; j++) {
+            unsigned int pairRanks = (1 << hole[i].rank) |
+                                     (1 << hole[j].rank);
+            if ((pairRanks & LOW_QUALIFIER_MASK) != pairRanks ||
+                __builtin_popcount(pairRanks) != OMAHA_HOLE_USED) {
+                continue;
+            } // endif
+            for (tripleIndex = 0; tripleIndex < tripleAmount; tripleIndex++) {
+                unsigned int lowRanks = pairRanks | tripleRanks[tripleIndex];
+                if (!(pairRanks & tripleRanks[tripleIndex])) {
+                    HandValue value = toLowValue(lowRanksTable[lowRanks]);
+                    if (value > bestValue) {
+                        bestValue = value;
+                    } // endif
+                } // endif
+            } // endfor
+        } // endfor
+    } // endfor
+    return bestValue;
+} // end function
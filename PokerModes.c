@@ -0,0 +1,624 @@
+
+/*---------------------------------------------------------------------------*\
+
+   Source code:  PokerModes.c
+        Author:  Marcel Riera
+
+   Description:  Source code containing the program modes selected by name
+                 in the first console argument, as an alternative to the
+                 default [Cards per hand] [Players] dealing program.
+
+                 Modes:
+                 verify [Samples]   Verifies fast evaluators against the
+                                    reference poker rank cascade
+                 flops [HoleCards]  Poker rank probabilities on the flop,
+                                    enumerated by suit isomorphism
+                 omaha HoleCards [Players] [Pot]
+                                    Deals and ranks an Omaha showdown with
+                                    4 or 5 hole cards per player, as eight
+                                    or better hi-lo splitting Pot chips
+                                    when given
+                 outs Board Hole1 Hole2 [Hole3...]
+                                    Outs and chances of every Hold'em
+                                    player on the flop or the turn
+                 deal Variant [Players] [Ranks]
+                                    Deals and ranks poker hands from the
+                                    deck of a variant: standard, short,
+                                    joker or deuces, optionally with a
+                                    custom rank list such as AKQJT98
+                 equity Width Seconds Board Hole1 Hole2 [Hole3...]
+                                    Hold'em equity sampled until its 95%
+                                    interval is Width percent wide or the
+                                    time runs out, - as Board preflop
+                 job Shard Shards File Board Hole1 Hole2 [Hole3...]
+                                    Runs or resumes one shard of the exact
+                                    Hold'em equity, saving to File, - as
+                                    the last hole for a random hand
+                 merge Output File1 [File2...]
+                                    Merges the result files of shards
+                 pushfold MaxStack [Samples]
+                                    Heads-up push or fold equilibrium of
+                                    every stack up to MaxStack big blinds
+                 audit File [Threads] [cache]
+                                    Evaluates every showdown of a hand
+                                    history log again and reports wrong
+                                    recorded winners, see PokerAudit.c
+
+                 This file is required for compilation of PokerHands.out, and
+                 must be in the same folder with MainCards.c, CardsValidation.c,
+                 CardsFunctions.c, PokerFunctions.c and Cards.h
+
+\*---------------------------------------------------------------------------*/
+
+#include "Cards.h"      // Required program header
+#include <string.h>     // Required for strcmp()
+#include <time.h>       // Required for seed randomization
+
+/**
+ * Function isProgramMode
+ * Checks whether a console argument names one of the program modes.
+ *
+ * @param argument  String argument input from argv.
+ * @return          TRUE if the argument is a mode name, FALSE otherwise
+ */
+
+int isProgramMode(char *argument) {
+    return (strcmp(argument, MODE_VERIFY) == 0 ||
+            strcmp(argument, MODE_FLOPS) == 0 ||
+            strcmp(argument, MODE_OMAHA) == 0 ||
+            strcmp(argument, MODE_OUTS) == 0 ||
+            strcmp(argument, MODE_DEAL) == 0 ||
+            strcmp(argument, MODE_EQUITY) == 0 ||
+            strcmp(argument, MODE_JOB) == 0 ||
+            strcmp(argument, MODE_MERGE) == 0 ||
+            strcmp(argument, MODE_PUSHFOLD) == 0 ||
+            strcmp(argument, MODE_AUDIT) == 0);
+} // end function
+
+/**
+ * Function parseHoldemDeal
+ * Parses the board and hole cards of a Hold'em deal from console arguments.
+ *
+ * @param boardText   board argument, EMPTY_BOARD before the flop
+ * @param holeTexts   hole cards argument of each player
+ * @param players     amount of players
+ * @param board       array of BOARD_SIZE cards receiving the board
+ * @param holes       array receiving HOLDEM_HOLE_SIZE cards per player
+ * @return            amount of board cards, or INVALID_INPUT
+ */
+
+static int parseHoldemDeal(char *boardText, char *holeTexts[], int players,
+                           Card board[], Card holes[]) {
+    int boardAmount = 0;
+    int player = 0;
+
+    if (strcmp(boardText, EMPTY_BOARD) != 0) {
+        boardAmount = parseCards(boardText, board, BOARD_SIZE);
+    } // endif
+    for (player = 0; player < players; player++) {
+        if (parseCards(holeTexts[player], holes + (player * HOLDEM_HOLE_SIZE),
+                       HOLDEM_HOLE_SIZE) != HOLDEM_HOLE_SIZE) {
+            boardAmount = INVALID_INPUT;
+        } // endif
+    } // endfor
+    return boardAmount;
+} // end function
+
+/**
+ * Function runVerifyMode
+ * Runs the verify mode: verify [Samples]
+ *
+ * @param argc   parameter argc from main execution
+ * @param argv   parameter argv from main execution
+ * @return       program exit code
+ */
+
+static int runVerifyMode(int argc, char *argv[]) {
+    long samples = VERIFY_DEFAULT_SAMPLES;
+
+    if (argc > VERIFY_SAMPLES_INDEX) {
+        samples = validateCountArgument(argv[VERIFY_SAMPLES_INDEX]);
+        if (samples == INVALID_INPUT) {
+            wprintf(L"verify expects a positive amount of samples\n");
+            return INVALID_INPUT;
+        } // endif
+    } // endif
+    return runVerification(samples);
+} // end function
+
+/**
+ * Function runFlopsMode
+ * Runs the flops mode: flops [HoleCards], such as flops AsKs
+ *
+ * @param argc   parameter argc from main execution
+ * @param argv   parameter argv from main execution
+ * @return       program exit code
+ */
+
+static int runFlopsMode(int argc, char *argv[]) {
+    Card hole[OMAHA_HOLE_SIZE] = {};
+    double distribution[STRAIGHT_FLUSH + 1] = {};
+    int holeAmount = 0;
+    long classes = 0;
+    int rank = 0;
+
+    if (argc > FLOPS_HOLE_INDEX) {
+        holeAmount = parseCards(argv[FLOPS_HOLE_INDEX], hole,
+                                OMAHA_HOLE_SIZE);
+        if (holeAmount == INVALID_INPUT || __builtin_popcountll(
+                cardsToMask(hole, holeAmount)) != holeAmount) {
+            wprintf(L"flops expects different cards such as AsKd\n");
+            return INVALID_INPUT;
+        } // endif
+    } // endif
+    classes = calcFlopRanks(cardsToMask(hole, holeAmount), distribution);
+    if (classes == INVALID_INPUT) {
+        return INVALID_INPUT;
+    } // endif
+
+    wprintf(L"Hole cards: ");
+    for (rank = 0; rank < holeAmount; rank++) {
+        displayCard(hole[rank]);
+    } // endfor
+    wprintf(L"\nCanonical flops evaluated: %ld\n", classes);
+    for (rank = HIGH_CARD; rank <= STRAIGHT_FLUSH; rank++) {
+        wprintf(L"%-16ls %8.4f%%\n", POKER_RANK_STRING[rank],
+                distribution[rank] * 100);
+    } // endfor
+    return NO_ERRORS;
+} // end function
+
+/**
+ * Function runOutsMode
+ * Runs the outs mode: outs Board Hole1 Hole2 [Hole3...], such as
+ * outs 9h8h2c AhKh QdQc
+ *
+ * @param argc   parameter argc from main execution
+ * @param argv   parameter argv from main execution
+ * @return       program exit code
+ */
+
+static int runOutsMode(int argc, char *argv[]) {
+    Card board[BOARD_SIZE] = {};
+    Card holes[MAX_PLAYERS * HOLDEM_HOLE_SIZE] = {};
+    OutsResult results[MAX_PLAYERS] = {};
+    int players = argc - OUTS_FIRST_HOLE_INDEX;
+    int boardAmount = 0;
+
+    if (argc <= OUTS_BOARD_INDEX || players < 2 || players > MAX_PLAYERS) {
+        wprintf(L"outs expects a board and 2-%d hole cards\n", MAX_PLAYERS);
+        return INVALID_INPUT;
+    } // endif
+    boardAmount = parseHoldemDeal(argv[OUTS_BOARD_INDEX],
+                                  argv + OUTS_FIRST_HOLE_INDEX, players,
+                                  board, holes);
+    if (boardAmount == INVALID_INPUT ||
+        calcOuts(holes, players, board, boardAmount, results) ==
+        INVALID_INPUT) {
+        wprintf(L"outs expects a 3 or 4 card board and different cards\n");
+        return INVALID_INPUT;
+    } // endif
+    displayOuts(results, players);
+    return NO_ERRORS;
+} // end function
+
+/**
+ * Function runOmahaMode
+ * Runs the omaha mode: omaha HoleCards [Players] [Pot], such as omaha 4 6,
+ * or omaha 4 6 101 for a hi-lo pot of 101 chips
+ *
+ * FORMULAS
+ *  (DECK_SIZE - BOARD_SIZE) / holeAmount
+ *   Most players the deck can deal hole cards to after the board.
+ *
+ * @param argc   parameter argc from main execution
+ * @param argv   parameter argv from main execution
+ * @return       program exit code
+ */
+
+static int runOmahaMode(int argc, char *argv[]) {
+    Card deck[DECK_SIZE] = {};
+    HandValue values[MAX_PLAYERS] = {};
+    HandValue lows[MAX_PLAYERS] = {};
+    long shares[MAX_PLAYERS] = {};
+    const Card *board = NULL;
+    long holeAmount = 0;
+    long players = 2;
+    long pot = 0;
+    int maxPlayers = MAX_PLAYERS;
+    int player = 0;
+
+    if (argc > OMAHA_HOLE_INDEX) {
+        holeAmount = validateCountArgument(argv[OMAHA_HOLE_INDEX]);
+    } // endif
+    if (holeAmount != OMAHA_HOLE_SIZE && holeAmount != PLO5_HOLE_SIZE) {
+        wprintf(L"omaha expects %d or %d hole cards\n", OMAHA_HOLE_SIZE,
+                PLO5_HOLE_SIZE);
+        return INVALID_INPUT;
+    } // endif
+    if ((DECK_SIZE - BOARD_SIZE) / holeAmount < maxPlayers) {
+        maxPlayers = (DECK_SIZE - BOARD_SIZE) / holeAmount;
+    } // endif
+    if (argc > OMAHA_PLAYERS_INDEX) {
+        players = validateCountArgument(argv[OMAHA_PLAYERS_INDEX]);
+    } // endif
+    if (argc > OMAHA_POT_INDEX) {
+        pot = validateCountArgument(argv[OMAHA_POT_INDEX]);
+    } // endif
+    if (players == INVALID_INPUT || players < 2 || players > maxPlayers ||
+        pot == INVALID_INPUT) {
+        wprintf(L"omaha expects 2-%d players and a positive pot\n",
+                maxPlayers);
+        return INVALID_INPUT;
+    } // endif
+
+    initializeDeck(deck);
+    shuffleDeck(deck);
+    board = deck + (players * holeAmount);
+    evaluateOmahaPlayers(deck, holeAmount, players, board, BOARD_SIZE,
+                         values);
+    if (pot == 0) {
+        displayOmahaPlayers(deck, holeAmount, players, board, values, NULL,
+                            NULL);
+        return NO_ERRORS;
+    } // endif
+    for (player = 0; player < players; player++) {
+        lows[player] = evaluateOmahaLow(deck + (player * holeAmount),
+                                        holeAmount, board, BOARD_SIZE);
+    } // endfor
+    splitPot(values, lows, players, pot, shares);
+    displayOmahaPlayers(deck, holeAmount, players, board, values, lows,
+                        shares);
+    return NO_ERRORS;
+} // end function
+
+/**
+ * Function runDealMode
+ * Runs the deal mode: deal Variant [Players] [Ranks], such as deal short 4,
+ * or deal standard 3 AKQJT98 to deal with the variant's rules from a deck
+ * holding only the listed ranks
+ *
+ * @param argc   parameter argc from main execution
+ * @param argv   parameter argv from main execution
+ * @return       program exit code
+ */
+
+static int runDealMode(int argc, char *argv[]) {
+    const DeckVariant *variant = NULL;
+    DeckVariant custom = {};
+    Card deck[MAX_DECK_SIZE] = {};
+    Hand hands[MAX_PLAYERS] = {};
+    long players = 2;
+    int deckSize = 0;
+    int maxPlayers = 0;
+
+    if (argc > DEAL_VARIANT_INDEX) {
+        variant = findDeckVariant(argv[DEAL_VARIANT_INDEX]);
+    } // endif
+    if (variant == NULL) {
+        wprintf(L"deal expects a variant: standard, short, joker or "
+                L"deuces\n");
+        return INVALID_INPUT;
+    } // endif
+    if (argc > DEAL_RANKS_INDEX) {
+        custom = *variant;
+        if (parseRanks(argv[DEAL_RANKS_INDEX], &custom.ranks) ==
+            INVALID_INPUT) {
+            wprintf(L"deal expects different ranks such as AKQJT98\n");
+            return INVALID_INPUT;
+        } // endif
+        variant = &custom;
+    } // endif
+    deckSize = initializeVariantDeck(deck, variant);
+    maxPlayers = deckSize / POKER_HAND_SIZE;
+    if (maxPlayers > MAX_PLAYERS) {
+        maxPlayers = MAX_PLAYERS;
+    } // endif
+    if (argc > DEAL_PLAYERS_INDEX) {
+        players = validateCountArgument(argv[DEAL_PLAYERS_INDEX]);
+    } // endif
+    if (maxPlayers < 1) {
+        wprintf(L"deal expects a deck of at least %d cards\n",
+                POKER_HAND_SIZE);
+        return INVALID_INPUT;
+    } // endif
+    if (players == INVALID_INPUT || players > maxPlayers) {
+        wprintf(L"deal expects 1-%d players\n", maxPlayers);
+        return INVALID_INPUT;
+    } // endif
+
+    displayCards(deck, deckSize, L"Original Ordered Deck:");
+    shuffleCards(deck, deckSize);
+    displayCards(deck, deckSize, L"Random Shuffled Deck:");
+    drawHands(deck, hands, players);
+    sortHands(hands, players);
+    rankVariantHands(hands, players, variant);
+    displayHands(hands, players, WITH_RANK, L"ranked");
+    displayHands(hands, players, WITH_WINNERS, L"winner(s)");
+    return NO_ERRORS;
+} // end function
+
+/**
+ * Function runEquityMode
+ * Runs the equity mode: equity Width Seconds Board Hole1 Hole2 [Hole3...],
+ * such as equity 0.5 2 - AsKs QdQc
+ *
+ * @param argc   parameter argc from main execution
+ * @param argv   parameter argv from main execution
+ * @return       program exit code
+ */
+
+static int runEquityMode(int argc, char *argv[]) {
+    Card board[BOARD_SIZE] = {};
+    Card holes[MAX_PLAYERS * HOLDEM_HOLE_SIZE] = {};
+    EquityResult result = {};
+    int players = argc - EQUITY_FIRST_HOLE_INDEX;
+    double width = 0;
+    double seconds = 0;
+    int boardAmount = 0;
+
+    if (argc <= EQUITY_BOARD_INDEX || players < 2 || players > MAX_PLAYERS) {
+        wprintf(L"equity expects a width, seconds, a board and 2-%d hole "
+                L"cards\n", MAX_PLAYERS);
+        return INVALID_INPUT;
+    } // endif
+    width = validateRealArgument(argv[EQUITY_WIDTH_INDEX]);
+    seconds = validateRealArgument(argv[EQUITY_SECONDS_INDEX]);
+    if (width == INVALID_INPUT || seconds == INVALID_INPUT) {
+        wprintf(L"equity expects a positive width in percent and seconds\n");
+        return INVALID_INPUT;
+    } // endif
+    boardAmount = parseHoldemDeal(argv[EQUITY_BOARD_INDEX],
+                                  argv + EQUITY_FIRST_HOLE_INDEX, players,
+                                  board, holes);
+    if (boardAmount == INVALID_INPUT ||
+        calcAdaptiveEquity(holes, players, board, boardAmount, width / 100,
+                           seconds, &result) == INVALID_INPUT) {
+        wprintf(L"equity expects a board of up to 5 and different cards\n");
+        return INVALID_INPUT;
+    } // endif
+    displayEquity(&result, players);
+    return NO_ERRORS;
+} // end function
+
+/**
+ * Function runJobMode
+ * Runs the job mode: job Shard Shards File Board Hole1 Hole2 [Hole3...],
+ * such as job 1 4 shard1.job - AsKs QdQc, resuming from File when it holds
+ * the same shard. The last hole may be EMPTY_BOARD to enumerate every hand
+ * of that player, such as job 1 4 shard1.job - AsKs - for the preflop
+ * equity of AsKs against a random hand.
+ *
+ * @param argc   parameter argc from main execution
+ * @param argv   parameter argv from main execution
+ * @return       program exit code
+ */
+
+static int runJobMode(int argc, char *argv[]) {
+    Card board[BOARD_SIZE] = {};
+    Card holes[MAX_PLAYERS * HOLDEM_HOLE_SIZE] = {};
+    JobResult job = {};
+    JobResult saved = {};
+    int players = argc - JOB_FIRST_HOLE_INDEX;
+    int randomHole = FALSE;
+    long shard = 0;
+    long shards = 0;
+    int boardAmount = 0;
+
+    if (argc <= JOB_BOARD_INDEX || players < 2 || players > MAX_PLAYERS) {
+        wprintf(L"job expects a shard, shards, a file, a board and 2-%d "
+                L"hole cards\n", MAX_PLAYERS);
+        return INVALID_INPUT;
+    } // endif
+    shard = validateCountArgument(argv[JOB_SHARD_INDEX]);
+    shards = validateCountArgument(argv[JOB_SHARDS_INDEX]);
+    randomHole = (strcmp(argv[argc - 1], EMPTY_BOARD) == 0);
+    boardAmount = parseHoldemDeal(argv[JOB_BOARD_INDEX],
+                                  argv + JOB_FIRST_HOLE_INDEX,
+                                  players - randomHole, board, holes);
+    if (shard == INVALID_INPUT || shards == INVALID_INPUT ||
+        boardAmount == INVALID_INPUT ||
+        initializeJob(&job, holes, players, randomHole, board, boardAmount,
+                      shard - 1, shards) == INVALID_INPUT) {
+        wprintf(L"job expects shard 1-Shards of up to %d shards, a board of "
+                L"up to 5 and different cards\n", MAX_SHARDS);
+        return INVALID_INPUT;
+    } // endif
+
+    if (loadJob(argv[JOB_FILE_INDEX], &saved) == VALID_INPUT) {
+        if (!isSameJob(&saved, &job) || saved.shardMask != job.shardMask) {
+            wprintf(L"%s holds another job or shard\n", argv[JOB_FILE_INDEX]);
+            return INVALID_INPUT;
+        } // endif
+        job = saved;
+        wprintf(L"Resuming with %lld deals left\n", job.end - job.next);
+    } // endif
+    if (runJobShard(argv[JOB_FILE_INDEX], &job) == INVALID_INPUT) {
+        wprintf(L"could not save %s\n", argv[JOB_FILE_INDEX]);
+        return INVALID_INPUT;
+    } // endif
+    displayJob(&job);
+    return NO_ERRORS;
+} // end function
+
+/**
+ * Function runMergeMode
+ * Runs the merge mode: merge Output File1 [File2...], such as
+ * merge all.job shard1.job shard2.job
+ *
+ * @param argc   parameter argc from main execution
+ * @param argv   parameter argv from main execution
+ * @return       program exit code
+ */
+
+static int runMergeMode(int argc, char *argv[]) {
+    JobResult merged = {};
+    int input = 0;
+
+    if (argc <= MERGE_FIRST_INPUT_INDEX) {
+        wprintf(L"merge expects an output file and result files\n");
+        return INVALID_INPUT;
+    } // endif
+    for (input = MERGE_FIRST_INPUT_INDEX; input < argc; input++) {
+        JobResult part = {};
+        if (loadJob(argv[input], &part) == INVALID_INPUT ||
+            mergeJobs(&merged, &part) == INVALID_INPUT) {
+            wprintf(L"%s is not a finished shard of the same job\n",
+                    argv[input]);
+            return INVALID_INPUT;
+        } // endif
+    } // endfor
+    if (saveJob(argv[MERGE_OUTPUT_INDEX], &merged) == INVALID_INPUT) {
+        wprintf(L"could not save %s\n", argv[MERGE_OUTPUT_INDEX]);
+        return INVALID_INPUT;
+    } // endif
+    displayJob(&merged);
+    return NO_ERRORS;
+} // end function
+
+/**
+ * Function runPushFoldMode
+ * Runs the pushfold mode: pushfold MaxStack [Samples], such as pushfold 20
+ *
+ * @param argc   parameter argc from main execution
+ * @param argv   parameter argv from main execution
+ * @return       program exit code
+ */
+
+static int runPushFoldMode(int argc, char *argv[]) {
+    PushFoldTable *table = NULL;
+    PushFoldResult *results = NULL;
+    double maxStack = 0;
+    double largestStack = 1 + (MAX_STACKS - 1) * PUSHFOLD_STACK_STEP;
+    long samples = PUSHFOLD_SAMPLES;
+    int resultAmount = 0;
+    int threads = getThreadAmount();
+    int index = 0;
+
+    if (argc > PUSHFOLD_STACK_INDEX) {
+        maxStack = validateRealArgument(argv[PUSHFOLD_STACK_INDEX]);
+    } // endif
+    if (argc > PUSHFOLD_SAMPLES_INDEX) {
+        samples = validateCountArgument(argv[PUSHFOLD_SAMPLES_INDEX]);
+    } // endif
+
+    // Bounded before the conversion, as strtod() accepts "inf" and 1e300
+    if (maxStack < 1 || maxStack > largestStack || samples == INVALID_INPUT) {
+        wprintf(L"pushfold expects a largest stack from 1 to %.0f big blinds "
+                L"and a positive amount of samples\n", largestStack);
+        return INVALID_INPUT;
+    } // endif
+    resultAmount = (maxStack - 1) / PUSHFOLD_STACK_STEP + 1;
+    table = malloc(sizeof(PushFoldTable));
+    results = calloc(resultAmount, sizeof(PushFoldResult));
+    if (table == NULL || results == NULL) {
+        free(table);
+        free(results);
+        return INVALID_INPUT;
+    } // endif
+
+    for (index = 0; index < resultAmount; index++) {
+        results[index].stack = 1 + index * PUSHFOLD_STACK_STEP;
+    } // endfor
+    createPushFoldTable(table, samples, threads);
+    solvePushFoldSweep(table, results, resultAmount, threads);
+    displayPushFoldSweep(table, results, resultAmount);
+    free(table);
+    free(results);
+    return NO_ERRORS;
+} // end function
+
+/**
+ * Function runAuditMode
+ * Runs the audit mode: audit File [Threads] [cache], such as audit hands.log
+ * 8, adding cache to evaluate through per thread caches for logs replaying
+ * the same deals
+ *
+ * @param argc   parameter argc from main execution
+ * @param argv   parameter argv from main execution
+ * @return       program exit code
+ */
+
+static int runAuditMode(int argc, char *argv[]) {
+    AuditChunk totals = {};
+    EvalCache cacheTotals = {};
+    EvalCache *caches = NULL;
+    struct timespec start = {};
+    struct timespec stop = {};
+    long threads = getThreadAmount();
+    long size = 0;
+
+    if (argc > AUDIT_THREADS_INDEX) {
+        threads = validateCountArgument(argv[AUDIT_THREADS_INDEX]);
+    } // endif
+    if (argc > AUDIT_CACHE_INDEX) {
+        caches = &cacheTotals;
+    } // endif
+    if (argc <= AUDIT_FILE_INDEX || threads == INVALID_INPUT ||
+        threads > MAX_THREADS || (caches != NULL &&
+        strcmp(argv[AUDIT_CACHE_INDEX], AUDIT_CACHE_OPTION) != 0)) {
+        wprintf(L"audit expects a hand history file, from 1 to %d threads "
+                L"and optionally %s\n", MAX_THREADS, AUDIT_CACHE_OPTION);
+        return INVALID_INPUT;
+    } // endif
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    size = auditFile(argv[AUDIT_FILE_INDEX], threads, &totals, caches);
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+    if (size == INVALID_INPUT) {
+        wprintf(L"could not audit %s\n", argv[AUDIT_FILE_INDEX]);
+        return INVALID_INPUT;
+    } // endif
+    displayAudit(&totals, caches, size, (stop.tv_sec - start.tv_sec) +
+                 (stop.tv_nsec - start.tv_nsec) / 1e9);
+    return (totals.mismatches > 0) ? AUDIT_FAILED : NO_ERRORS;
+} // end function
+
+/**
+ * Function runProgramMode
+ * Redirects execution to the program mode named by argv[MODE_INDEX].
+ *
+ * @param argc   parameter argc from main execution
+ * @param argv   parameter argv from main execution
+ * @return       program exit code
+ */
+
+int runProgramMode(int argc, char *argv[]) {
+    char *mode = argv[MODE_INDEX];
+
+    srand(time(NULL));
+    setUnicodeMode();
+    initializeEvaluator();
+
+    if (strcmp(mode, MODE_VERIFY) == 0) {
+        return runVerifyMode(argc, argv);
+    } // endif
+    else if (strcmp(mode, MODE_FLOPS) == 0) {
+        return runFlopsMode(argc, argv);
+    } // endif
+    else if (strcmp(mode, MODE_OUTS) == 0) {
+        return runOutsMode(argc, argv);
+    } // endif
+    else if (strcmp(mode, MODE_OMAHA) == 0) {
+        return runOmahaMode(argc, argv);
+    } // endif
+    else if (strcmp(mode, MODE_DEAL) == 0) {
+        return runDealMode(argc, argv);
+    } // endif
+    else if (strcmp(mode, MODE_EQUITY) == 0) {
+        return runEquityMode(argc, argv);
+    } // endif
+    else if (strcmp(mode, MODE_JOB) == 0) {
+        return runJobMode(argc, argv);
+    } // endif
+    else if (strcmp(mode, MODE_MERGE) == 0) {
+        return runMergeMode(argc, argv);
+    } // endif
+    else if (strcmp(mode, MODE_PUSHFOLD) == 0) {
+        return runPushFoldMode(argc, argv);
+    } // endif
+    else if (strcmp(mode, MODE_AUDIT) == 0) {
+        return runAuditMode(argc, argv);
+    } // endif
+    return INVALID_INPUT;
+} // end function
@@ -0,0 +1,376 @@
+
+/*---------------------------------------------------------------------------*\
+
+   Source code:  PokerOmaha.c
+        Author:  Marcel Riera
+
+   Description:  Source code containing the Omaha evaluator, for four hole
+                 card Omaha and five hole card Omaha (PLO5). A player must use
+                 exactly two hole cards and three board cards.
+
+                 Instead of evaluating every two plus three card combination,
+                 the board is prepared once for all players: its triples are
+                 grouped by rank pattern, monotone triples are marked as flush
+                 candidates, and the best non flush value for each pair of
+                 hole ranks is memorized. The first hole pair of some ranks
+                 still evaluates every board pattern, so the memo mostly
+                 pays off for the players after the first one, who often
+                 cost one lookup per hole pair plus the few combinations
+                 that can make a flush. evaluateOmahaPlayers() prepares the
+                 board once for a whole deal, as the omaha mode does.
+
+                 This file is required for compilation of PokerHands.out, and
+                 must be in the same folder with MainCards.c, CardsValidation.c,
+                 CardsFunctions.c, PokerFunctions.c and Cards.h
+
+\*---------------------------------------------------------------------------*/
+
+#include "Cards.h"      // Required program header
+
+/**
+ * Function makeOmahaPart
+ * Builds the rank counts, mask and shared suit of a group of cards.
+ *
+ * FORMULAS
+ *  counts[n] & bit
+ *   The rank was already seen n + 1 times, so it moves up to counts[n + 1].
+ *
+ * @param cards        cards of the group
+ * @param cardAmount   amount of cards in the group
+ * @param part         part to fill
+ */
+
+static void makeOmahaPart(const Card cards[], int cardAmount,
+                          OmahaPart *part) {
+    int cardIndex = 0;
+    int count = 0;
+
+    part->mask = 0;
+    part->suit = cards[FIRST_CARD].suit;
+    for (count = 0; count < CARD_TYPE_AMOUNT; count++) {
+        part->counts[count] = 0;
+    } // endfor
+    for (cardIndex = 0; cardIndex < cardAmount; cardIndex++) {
+        unsigned int bit = 1 << getHighRank(cards[cardIndex].rank);
+        count = 0;
+        while (part->counts[count] & bit) {
+            count++;
+        } // endwhile
+        part->counts[count] |= bit;
+        part->mask |= getCardMask(cards[cardIndex]);
+        if ((int) cards[cardIndex].suit != part->suit) {
+            part->suit = NO_SUIT;
+        } // endif
+    } // endfor
+} // end function
+
+/**
+ * Function isSamePattern
+ * Checks whether two parts hold the same ranks the same amount of times.
+ *
+ * @param first    first part to compare
+ * @param second   second part to compare
+ * @return         TRUE if both rank patterns are equal, FALSE otherwise
+ */
+
+static int isSamePattern(const OmahaPart *first, const OmahaPart *second) {
+    int count = 0;
+
+    for (count = 0; count < CARD_TYPE_AMOUNT; count++) {
+        if (first->counts[count] != second->counts[count]) {
+            return FALSE;
+        } // endif
+    } // endfor
+    return TRUE;
+} // end function
+
+/**
+ * Function prepareOmahaBoard
+ * Prepares a board of three to five cards for evaluating any amount of
+ * Omaha players against it.
+ *
+ * @param board        board cards
+ * @param boardAmount  amount of board cards, from FLOP_SIZE to BOARD_SIZE
+ * @param prepared     prepared board to fill
+ */
+
+void prepareOmahaBoard(const Card board[], int boardAmount,
+                       OmahaBoard *prepared) {
+    int i = 0, j = 0, k = 0;
+    int patternIndex = 0;
+
+    prepared->tripleAmount = 0;
+    prepared->patternAmount = 0;
+    prepared->flushSuits = 0;
+    for (i = 0; i < boardAmount; i++) {
+        for (j = i + 1; j < boardAmount; j++) {
+            for (k = j + 1; k < boardAmount; k++) {
+                Card triple[] = {board[i], board[j], board[k]};
+                OmahaPart *part = &prepared->triples[prepared->tripleAmount];
+                int isNewPattern = TRUE;
+
+                makeOmahaPart(triple, OMAHA_BOARD_USED, part);
+                prepared->tripleAmount++;
+                if (part->suit != NO_SUIT) {
+                    prepared->flushSuits |= 1 << part->suit;
+                } // endif
+                for (patternIndex = 0; patternIndex < prepared->patternAmount;
+                     patternIndex++) {
+                    if (isSamePattern(part,
+                                      &prepared->patterns[patternIndex])) {
+                        isNewPattern = FALSE;
+                    } // endif
+                } // endfor
+                if (isNewPattern) {
+                    prepared->patterns[prepared->patternAmount] = *part;
+                    prepared->patternAmount++;
+                } // endif
+            } // endfor
+        } // endfor
+    } // endfor
+    for (i = 0; i < CARD_NUMBERS_AMOUNT; i++) {
+        for (j = 0; j < CARD_NUMBERS_AMOUNT; j++) {
+            prepared->pairValues[i][j] = 0;
+        } // endfor
+    } // endfor
+} // end function
+
+/**
+ * Function evaluatePairPattern
+ * Calculates the best non flush value of a hole pair with every board rank
+ * pattern.
+ *
+ * FORMULAS
+ *  merged(n) = OR of pair(i) & triple(n - i)
+ *   A rank appears at least n times in the five cards when it appears i
+ *   times in the pair and n - i times in the triple, for some i.
+ *
+ * @param pair       hole pair to evaluate
+ * @param prepared   prepared board
+ * @return           best non flush value of the pair
+ */
+
+static HandValue evaluatePairPattern(const OmahaPart *pair,
+                                     const OmahaBoard *prepared) {
+    HandValue bestValue = 0;
+    int patternIndex = 0;
+
+    for (patternIndex = 0; patternIndex < prepared->patternAmount;
+         patternIndex++) {
+        const unsigned int *tc = prepared->patterns[patternIndex].counts;
+        const unsigned int *pc = pair->counts;
+        unsigned int merged[CARD_TYPE_AMOUNT] = {};
+        HandValue value = 0;
+
+        merged[0] = pc[0] | tc[0];
+        merged[1] = pc[1] | tc[1] | (pc[0] & tc[0]);
+        merged[2] = tc[2] | (pc[0] & tc[1]) | (pc[1] & tc[0]);
+        merged[3] = (pc[0] & tc[2]) | (pc[1] & tc[1]);
+        value = evaluateNoFlush(merged);
+        if (value > bestValue) {
+            bestValue = value;
+        } // endif
+    } // endfor
+    return bestValue;
+} // end function
+
+/**
+ * Function evaluateOmaha
+ * Calculates the best value of an Omaha hand using exactly two hole cards
+ * and three board cards. Non flush values are shared between hole pairs of
+ * the same ranks, and only suited hole pairs matching a monotone board
+ * triple are evaluated as flush candidates.
+ *
+ * @param hole         hole cards of the player
+ * @param holeAmount   OMAHA_HOLE_SIZE or PLO5_HOLE_SIZE
+ * @param prepared     board prepared by prepareOmahaBoard()
+ * @return             comparable hand value
+ */
+
+HandValue evaluateOmaha(const Card hole[], int holeAmount,
+                        OmahaBoard *prepared) {
+    HandValue bestValue = 0;
+    int i = 0, j = 0;
+    int tripleIndex = 0;
+
+    for (i = 0; i < holeAmount; i++) {
+        for (j = i + 1; j < holeAmount; j++) {
+            Card pairCards[] = {hole[i], hole[j]};
+            int high = getHighRank(hole[i].rank);
+            int low = getHighRank(hole[j].rank);
+            OmahaPart pair = {};
+            HandValue value = 0;
+
+            if (low > high) {
+                int tmp = low;
+                low = high;
+                high = tmp;
+            } // endif
+            makeOmahaPart(pairCards, OMAHA_HOLE_USED, &pair);
+            value = prepared->pairValues[high][low];
+            if (value == 0) {
+                value = evaluatePairPattern(&pair, prepared);
+                prepared->pairValues[high][low] = value;
+            } // endif
+            if (value > bestValue) {
+                bestValue = value;
+            } // endif
+
+            if (pair.suit == NO_SUIT ||
+                !(prepared->flushSuits & (1 << pair.suit))) {
+                continue;
+            } // endif
+            for (tripleIndex = 0; tripleIndex < prepared->tripleAmount;
+                 tripleIndex++) {
+                const OmahaPart *triple = &prepared->triples[tripleIndex];
+                if (triple->suit == pair.suit) {
+                    value = evaluateMask(pair.mask | triple->mask);
+                    if (value > bestValue) {
+                        bestValue = value;
+                    } // endif
+                } // endif
+            } // endfor
+        } // endfor
+    } // endfor
+    return bestValue;
+} // end function
+
+/**
+ * Function evaluateOmahaNaive
+ * Calculates the best value of an Omaha hand by evaluating every two hole
+ * card and three board card combination. Used as the baseline for
+ * verifyOmaha().
+ *
+ * @param hole          hole cards of the player
+ * @param holeAmount    amount of hole cards
+ * @param board         board cards
+ * @param boardAmount   amount of board cards
+ * @return              comparable hand value
+ */
+
+HandValue evaluateOmahaNaive(const Card hole[], int holeAmount,
+                             const Card board[], int boardAmount) {
+    HandValue bestValue = 0;
+    int h1 = 0, h2 = 0, b1 = 0, b2 = 0, b3 = 0;
+
+    for (h1 = 0; h1 < holeAmount; h1++) {
+    for (h2 = h1 + 1; h2 < holeAmount; h2++) {
+    for (b1 = 0; b1 < boardAmount; b1++) {
+    for (b2 = b1 + 1; b2 < boardAmount; b2++) {
+    for (b3 = b2 + 1; b3 < boardAmount; b3++) {
+        Card cards[] = {hole[h1], hole[h2], board[b1], board[b2], board[b3]};
+        HandValue value = evaluateCards(cards, POKER_HAND_SIZE);
+        if (value > bestValue) {
+            bestValue = value;
+        } // endif
+    } // endfor
+    } // endfor
+    } // endfor
+    } // endfor
+    } // endfor
+    return bestValue;
+} // end function
+
+/**
+ * Function evaluateOmahaPlayers
+ * Evaluates every player of an Omaha deal against the same board, which is
+ * prepared only once.
+ *
+ * FORMULAS
+ *  holes + (player * holeAmount)
+ *   Hole cards are stored one player after the other.
+ *
+ * @param holes         hole cards of all players
+ * @param holeAmount    hole cards per player
+ * @param players       amount of players
+ * @param board         board cards
+ * @param boardAmount   amount of board cards
+ * @param values        array receiving the value of each player
+ */
+
+void evaluateOmahaPlayers(const Card holes[], int holeAmount, int players,
+                          const Card board[], int boardAmount,
+                          HandValue values[]) {
+    OmahaBoard prepared = {};
+    int player = 0;
+
+    prepareOmahaBoard(board, boardAmount, &prepared);
+    for (player = 0; player < players; player++) {
+        values[player] = evaluateOmaha(holes + (player * holeAmount),
+                                       holeAmount, &prepared);
+    } // endfor
+} // end function
+
+/**
+ * Function displayOmahaLow
+ * Displays an eight or better low by its ranks, highest first, such as
+ * 8-6-4-2-A.
+ *
+ * FORMULAS
+ *  (LOW_VALUE_LIMIT - low) >> (KICKER_BITS * n)
+ *   The low as a high hand holds the five ranks packed, highest first.
+ *
+ * @param low   low value, NO_LOW if it does not qualify
+ */
+
+static void displayOmahaLow(HandValue low) {
+    int index = 0;
+
+    if (low == NO_LOW) {
+        wprintf(L" - no low");
+        return;
+    } // endif
+    wprintf(L" - low ");
+    for (index = POKER_HAND_SIZE - 1; index >= 0; index--) {
+        int rank = ((LOW_VALUE_LIMIT - low) >> (KICKER_BITS * index)) & 0xF;
+        wprintf(index > 0 ? L"%c-" : L"%c", CARD_NUM_SYMBOL[rank]);
+    } // endfor
+} // end function
+
+/**
+ * Function displayOmahaPlayers
+ * Displays the board, and the hole cards and poker rank of every player of
+ * an Omaha deal. In a high only deal the players with the best value are
+ * marked; in a hi-lo deal each low and share of the pot is displayed.
+ *
+ * @param holes        hole cards of all players
+ * @param holeAmount   hole cards per player
+ * @param players      amount of players
+ * @param board        board cards, BOARD_SIZE of them
+ * @param values       value of each player, see evaluateOmahaPlayers()
+ * @param lows         low value of each player, NULL if high only
+ * @param shares       chips won by each player, NULL if high only
+ */
+
+void displayOmahaPlayers(const Card holes[], int holeAmount, int players,
+                         const Card board[], const HandValue values[],
+                         const HandValue lows[], const long shares[]) {
+    HandValue bestValue = 0;
+    int player = 0;
+    int cardIndex = 0;
+
+    for (player = 0; player < players; player++) {
+        if (values[player] > bestValue) {
+            bestValue = values[player];
+        } // endif
+    } // endfor
+    wprintf(L"Board: ");
+    for (cardIndex = 0; cardIndex < BOARD_SIZE; cardIndex++) {
+        displayCard(board[cardIndex]);
+    } // endfor
+    for (player = 0; player < players; player++) {
+        wprintf(L"\nPlayer  %d] - ", player + 1);
+        for (cardIndex = 0; cardIndex < holeAmount; cardIndex++) {
+            displayCard(holes[player * holeAmount + cardIndex]);
+        } // endfor
+        wprintf(L" - %ls", POKER_RANK_STRING[getValueRank(values[player])]);
+        if (lows != NULL) {
+            displayOmahaLow(lows[player]);
+            wprintf(L" - %ld chips", shares[player]);
+        } // endif
+        else if (values[player] == bestValue) {
+            wprintf(L" - winner");
+        } // endif
+    } // endfor
+    wprintf(L"\n");
+} // end function
@@ -0,0 +1,209 @@
+
+/*---------------------------------------------------------------------------*\
+
+   Source code:  PokerOuts.c
+        Author:  Marcel Riera
+
+   Description:  Source code containing the outs and draw probability
+                 calculator for Hold'em deals on the flop or the turn.
+                 Instead of shuffling and dealing scenarios, the unseen deck
+                 is a card mask whose bits are enumerated directly: every
+                 possible next card, and on the flop every turn and river
+                 pair, is added to each player's street state and evaluated.
+
+                 This file is required for compilation of PokerHands.out, and
+                 must be in the same folder with MainCards.c, CardsValidation.c,
+                 CardsFunctions.c, PokerFunctions.c and Cards.h
+
+\*---------------------------------------------------------------------------*/
+
+#include "Cards.h"      // Required program header
+
+/**
+ * Function markBestPlayers
+ * Finds the players holding the best value, ties included.
+ *
+ * @param values    value of each player
+ * @param players   amount of players
+ * @return          mask with bit n set when player n holds the best value
+ */
+
+static int markBestPlayers(const HandValue values[], int players) {
+    HandValue bestValue = 0;
+    int bestPlayers = 0;
+    int player = 0;
+
+    for (player = 0; player < players; player++) {
+        if (values[player] > bestValue) {
+            bestValue = values[player];
+            bestPlayers = 0;
+        } // endif
+        if (values[player] == bestValue) {
+            bestPlayers |= 1 << player;
+        } // endif
+    } // endfor
+    return bestPlayers;
+} // end function
+
+/**
+ * Function calcOuts
+ * Calculates for each player the outs and the exact chance of holding the
+ * best hand (ties included) after the next card and after the river. On
+ * the turn both chances are the same. Winning outs are the next cards that
+ * make a player best while another player is ahead now; a player already
+ * best has none. Improving outs are the next cards that raise the poker
+ * rank of a player above both its current one and the one the board makes
+ * alone with that card, so cards pairing the board do not count.
+ *
+ * FORMULAS
+ *  unseen & (unseen - 1)
+ *   Clears the lowest set bit, to walk the unseen cards of a mask.
+ *
+ *  turns * (turns - 1) / 2
+ *   Amount of unordered turn and river pairs from the unseen cards.
+ *
+ * @param holes         HOLDEM_HOLE_SIZE hole cards per player, one player
+ *                      after the other
+ * @param players       amount of players, up to MAX_PLAYERS
+ * @param board         board cards
+ * @param boardAmount   FLOP_SIZE or BOARD_SIZE - 1
+ * @param results       array receiving the outs of each player
+ * @return              VALID_INPUT, or INVALID_INPUT for an invalid deal
+ */
+
+int calcOuts(const Card holes[], int players, const Card board[],
+             int boardAmount, OutsResult results[]) {
+    StreetState states[MAX_PLAYERS] = {};
+    StreetState turnStates[MAX_PLAYERS] = {};
+    StreetState boardState = {};
+    HandValue values[MAX_PLAYERS] = {};
+    long turnHits[MAX_PLAYERS] = {};
+    long riverHits[MAX_PLAYERS] = {};
+    PokerRank currentRanks[MAX_PLAYERS] = {};
+    CardMask known = cardsToMask(board, boardAmount);
+    CardMask unseen = 0;
+    CardMask turnCards = 0;
+    long turns = 0;
+    long rivers = 0;
+    int aheadPlayers = 0;
+    int player = 0;
+
+    if (players < 1 || players > MAX_PLAYERS ||
+        (boardAmount != FLOP_SIZE && boardAmount != BOARD_SIZE - 1)) {
+        return INVALID_INPUT;
+    } // endif
+    for (player = 0; player < players; player++) {
+        const Card *hole = holes + (player * HOLDEM_HOLE_SIZE);
+        initializeStreetState(&states[player]);
+        addStreetCards(&states[player], hole, HOLDEM_HOLE_SIZE);
+        addStreetCards(&states[player], board, boardAmount);
+        values[player] = evaluateStreetState(&states[player]);
+        currentRanks[player] = getValueRank(values[player]);
+        known |= cardsToMask(hole, HOLDEM_HOLE_SIZE);
+        results[player].winningOuts = 0;
+        results[player].improvingOuts = 0;
+    } // endfor
+    if (__builtin_popcountll(known) !=
+        players * HOLDEM_HOLE_SIZE + boardAmount) {
+        return INVALID_INPUT;   // Repeated cards
+    } // endif
+    unseen = FULL_DECK_MASK & ~known;
+    turns = __builtin_popcountll(unseen);
+    aheadPlayers = markBestPlayers(values, players);
+    initializeStreetState(&boardState);
+    addStreetCards(&boardState, board, boardAmount);
+
+    for (turnCards = unseen; turnCards; turnCards &= turnCards - 1) {
+        int turn = __builtin_ctzll(turnCards);
+        StreetState turnBoard = boardState;
+        PokerRank boardRank = HIGH_CARD;
+        CardMask riverCards = 0;
+        int bestPlayers = 0;
+
+        addStreetBit(&turnBoard, turn);
+        boardRank = getValueRank(evaluateStreetState(&turnBoard));
+        for (player = 0; player < players; player++) {
+            PokerRank rank = HIGH_CARD;
+            turnStates[player] = states[player];
+            addStreetBit(&turnStates[player], turn);
+            values[player] = evaluateStreetState(&turnStates[player]);
+            rank = getValueRank(values[player]);
+            if (rank > currentRanks[player] && rank > boardRank) {
+                results[player].improvingOuts |= 1ULL << turn;
+            } // endif
+        } // endfor
+        bestPlayers = markBestPlayers(values, players);
+        for (player = 0; player < players; player++) {
+            if (bestPlayers & (1 << player)) {
+                turnHits[player]++;
+                if (!(aheadPlayers & (1 << player))) {
+                    results[player].winningOuts |= 1ULL << turn;
+                } // endif
+            } // endif
+        } // endfor
+        if (boardAmount != FLOP_SIZE) {
+            continue;
+        } // endif
+
+        // Rivers above the turn, so each pair is enumerated once
+        riverCards = turnCards & (turnCards - 1);
+        for (; riverCards; riverCards &= riverCards - 1) {
+            int river = __builtin_ctzll(riverCards);
+            for (player = 0; player < players; player++) {
+                StreetState riverState = turnStates[player];
+                addStreetBit(&riverState, river);
+                values[player] = evaluateStreetState(&riverState);
+            } // endfor
+            bestPlayers = markBestPlayers(values, players);
+            for (player = 0; player < players; player++) {
+                riverHits[player] += (bestPlayers >> player) & 1;
+            } // endfor
+            rivers++;
+        } // endfor
+    } // endfor
+
+    for (player = 0; player < players; player++) {
+        results[player].turnProbability = (double) turnHits[player] / turns;
+        results[player].riverProbability = results[player].turnProbability;
+        if (boardAmount == FLOP_SIZE) {
+            results[player].riverProbability = (double) riverHits[player] /
+                                               rivers;
+        } // endif
+    } // endfor
+    return VALID_INPUT;
+} // end function
+
+/**
+ * Function displayOuts
+ * Displays the outs and probabilities of every player.
+ *
+ * @param results   outs of each player
+ * @param players   amount of players
+ */
+
+void displayOuts(const OutsResult results[], int players) {
+    int player = 0;
+    int bit = 0;
+
+    for (player = 0; player < players; player++) {
+        wprintf(L"Player  %d] - best next card %6.2f%% - best on river "
+                L"%6.2f%%\n", player + 1,
+                results[player].turnProbability * 100,
+                results[player].riverProbability * 100);
+        wprintf(L"  Winning outs (%d): ",
+                __builtin_popcountll(results[player].winningOuts));
+        for (bit = 0; bit < DECK_SIZE; bit++) {
+            if (results[player].winningOuts & (1ULL << bit)) {
+                displayCard(getMaskCard(bit));
+            } // endif
+        } // endfor
+        wprintf(L"\n  Improving outs (%d): ",
+                __builtin_popcountll(results[player].improvingOuts));
+        for (bit = 0; bit < DECK_SIZE; bit++) {
+            if (results[player].improvingOuts & (1ULL << bit)) {
+                displayCard(getMaskCard(bit));
+            } // endif
+        } // endfor
+        wprintf(L"\n");
+    } // endfor
+} // end function
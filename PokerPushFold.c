@@ -0,0 +1,553 @@
+
+/*---------------------------------------------------------------------------*\
+
+   Source code:  PokerPushFold.c
+        Author:  Marcel Riera
+
+   Description:  Source code containing the heads-up push or fold solver.
+                 The small blind either folds or pushes all in, and the big
+                 blind either folds or calls. Starting hands are grouped in
+                 the 169 classes of suit isomorphism (pairs, suited and
+                 offsuit hands), and the all in equity of every class
+                 against every other is sampled once, in parallel, with
+                 card removal. That table does not depend on the stacks, so
+                 every stack of a sweep reuses it, and the equilibrium of
+                 each stack is found by fictitious play: both players play
+                 best responses to the average strategy of the other, whose
+                 averages converge to a Nash equilibrium.
+
+                 This file is required for compilation of PokerHands.out, and
+                 must be in the same folder with MainCards.c, CardsValidation.c,
+                 CardsFunctions.c, PokerFunctions.c and Cards.h
+
+\*---------------------------------------------------------------------------*/
+
+#include "Cards.h"      // Required program header
+#include <pthread.h>    // Required for worker threads
+#include <unistd.h>     // Required for sysconf()
+
+/**
+ * Function getHandClass
+ * Returns the class of two hole cards on the 13 x 13 chart, aces first:
+ * pairs on the diagonal, suited hands above it and offsuit hands below.
+ *
+ * FORMULAS
+ *  high * CARD_NUMBERS_AMOUNT + low
+ *   Row of the highest rank and column of the lowest for suited hands,
+ *   the other way around for offsuit hands.
+ *
+ * @param hole   card mask of two hole cards
+ * @return       hand class, from 0 to HAND_CLASSES - 1
+ */
+
+int getHandClass(CardMask hole) {
+    int first = __builtin_ctzll(hole);
+    int second = 63 - __builtin_clzll(hole);
+    int high = CARD_NUMBERS_AMOUNT - 1 - second % CARD_NUMBERS_AMOUNT;
+    int low = CARD_NUMBERS_AMOUNT - 1 - first % CARD_NUMBERS_AMOUNT;
+
+    if (high > low) {
+        int tmp = high;
+        high = low;
+        low = tmp;
+    } // endif
+    if (first / CARD_NUMBERS_AMOUNT == second / CARD_NUMBERS_AMOUNT) {
+        return high * CARD_NUMBERS_AMOUNT + low;
+    } // endif
+    return low * CARD_NUMBERS_AMOUNT + high;
+} // end function
+
+/**
+ * Function getThreadAmount
+ * Returns the amount of worker threads to start, one per online processor.
+ *
+ * @return   amount of threads, from 1 to MAX_THREADS
+ */
+
+int getThreadAmount() {
+    long processors = sysconf(_SC_NPROCESSORS_ONLN);
+
+    if (processors < 1) {
+        return 1;
+    } // endif
+    return (processors > MAX_THREADS) ? MAX_THREADS : (int) processors;
+} // end function
+
+/**
+ * Function nextRandom
+ * Advances a xorshift64* generator. Each row of the equity table owns one,
+ * so threads share no random state and results do not depend on the amount
+ * of threads.
+ * Retrieved from: https://en.wikipedia.org/wiki/Xorshift#xorshift*
+ *
+ * @param state   generator state, never 0
+ * @return        next pseudo random number
+ */
+
+static unsigned long long nextRandom(unsigned long long *state) {
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 0x2545F4914F6CDD1DULL;
+} // end function
+
+/**
+ * Function sampleClassEquity
+ * Samples the all in equity of one hand class against another, with card
+ * removal: combos of both classes are drawn until they share no card, and
+ * the board is drawn from the remaining cards.
+ *
+ * @param table     table with the combos of each class
+ * @param hero      class whose equity is sampled
+ * @param villain   opposing class
+ * @param samples   amount of boards to deal
+ * @param state     random generator state
+ * @return          share of the pots won by hero, ties split
+ */
+
+static double sampleClassEquity(const PushFoldTable *table, int hero,
+                                int villain, long samples,
+                                unsigned long long *state) {
+    long sample = 0;
+    long halfPots = 0;
+
+    for (sample = 0; sample < samples; sample++) {
+        CardMask heroCards = 0;
+        CardMask villainCards = 0;
+        CardMask dead = 0;
+        CardMask board = 0;
+        int dealt = 0;
+        HandValue heroValue = 0;
+        HandValue villainValue = 0;
+
+        do {
+            heroCards = table->combos[hero][(nextRandom(state) >> 32) %
+                                            table->comboAmounts[hero]];
+            villainCards = table->combos[villain][(nextRandom(state) >> 32) %
+                                                  table->comboAmounts[villain]];
+        } while (heroCards & villainCards);
+        dead = heroCards | villainCards;
+        while (dealt < BOARD_SIZE) {
+            CardMask card = 1ULL << ((nextRandom(state) >> 32) % DECK_SIZE);
+            if (!(dead & card)) {
+                board |= card;
+                dead |= card;
+                dealt++;
+            } // endif
+        } // endwhile
+        heroValue = evaluateMask(board | heroCards);
+        villainValue = evaluateMask(board | villainCards);
+        halfPots += (heroValue > villainValue) ? 2 :
+                    (heroValue == villainValue);
+    } // endfor
+    return halfPots / (2.0 * samples);
+} // end function
+
+/**
+ * Function runEquityRows
+ * Worker thread filling the equity of every row of the table whose index
+ * matches the thread, against the classes after it. The classes before it
+ * are filled by their own rows, as equities are complementary.
+ *
+ * @param argument   SolverTask of the thread
+ * @return           NULL
+ */
+
+static void *runEquityRows(void *argument) {
+    SolverTask *task = argument;
+    PushFoldTable *table = task->table;
+    int hero = 0;
+    int villain = 0;
+
+    for (hero = task->thread; hero < HAND_CLASSES; hero += task->threads) {
+        unsigned long long state = PUSHFOLD_SEED ^
+                                   ((hero + 1) * HASH_MULTIPLIER);
+        table->equity[hero][hero] = 0.5;  // Same class, by symmetry
+        for (villain = hero + 1; villain < HAND_CLASSES; villain++) {
+            double equity = sampleClassEquity(table, hero, villain,
+                                              task->samples, &state);
+            table->equity[hero][villain] = equity;
+            table->equity[villain][hero] = 1 - equity;
+        } // endfor
+    } // endfor
+    return NULL;
+} // end function
+
+/**
+ * Function runThreads
+ * Runs a worker function on several threads, each with its own task, and
+ * waits for all of them. Runs on the calling thread if threads cannot start.
+ *
+ * @param worker    worker function
+ * @param task      task shared by the workers, copied for each thread
+ * @param threads   amount of threads, up to MAX_THREADS
+ */
+
+static void runThreads(void *(*worker)(void *), const SolverTask *task,
+                       int threads) {
+    pthread_t ids[MAX_THREADS] = {};
+    SolverTask tasks[MAX_THREADS] = {};
+    int started[MAX_THREADS] = {};
+    int thread = 0;
+
+    for (thread = 0; thread < threads; thread++) {
+        tasks[thread] = *task;
+        tasks[thread].thread = thread;
+        tasks[thread].threads = threads;
+        started[thread] = (pthread_create(&ids[thread], NULL, worker,
+                                          &tasks[thread]) == 0);
+    } // endfor
+    for (thread = 0; thread < threads; thread++) {
+        if (started[thread]) {
+            pthread_join(ids[thread], NULL);
+        } // endif
+        else {
+            worker(&tasks[thread]);
+        } // endelse
+    } // endfor
+} // end function
+
+/**
+ * Function createPushFoldTable
+ * Fills the combos of each hand class, the amount of compatible combo pairs
+ * of every two classes and their sampled all in equity.
+ *
+ * @param table     table to fill
+ * @param samples   amount of boards per pair of classes
+ * @param threads   amount of worker threads, up to MAX_THREADS
+ */
+
+void createPushFoldTable(PushFoldTable *table, long samples, int threads) {
+    SolverTask task = {};
+    int first = 0;
+    int second = 0;
+    int hero = 0;
+    int villain = 0;
+
+    for (hero = 0; hero < HAND_CLASSES; hero++) {
+        table->comboAmounts[hero] = 0;
+    } // endfor
+    for (first = 0; first < DECK_SIZE; first++) {
+        for (second = first + 1; second < DECK_SIZE; second++) {
+            CardMask hole = (1ULL << first) | (1ULL << second);
+            int class = getHandClass(hole);
+            table->combos[class][table->comboAmounts[class]] = hole;
+            table->comboAmounts[class]++;
+        } // endfor
+    } // endfor
+    for (hero = 0; hero < HAND_CLASSES; hero++) {
+        for (villain = 0; villain < HAND_CLASSES; villain++) {
+            int weight = 0;
+            for (first = 0; first < table->comboAmounts[hero]; first++) {
+                for (second = 0; second < table->comboAmounts[villain];
+                     second++) {
+                    weight += !(table->combos[hero][first] &
+                                table->combos[villain][second]);
+                } // endfor
+            } // endfor
+            table->weights[hero][villain] = weight;
+        } // endfor
+    } // endfor
+
+    task.table = table;
+    task.samples = samples;
+    runThreads(runEquityRows, &task, threads);
+} // end function
+
+/**
+ * Function fillStackMatrices
+ * Fills the payoffs of one stack. The small blind result of pushing hero
+ * against calling frequencies is 1 + sum of pushMatrix[hero][n] * call[n],
+ * and the big blind gain of calling with hero instead of folding against
+ * pushing frequencies is the sum of callMatrix[hero][n] * push[n].
+ *
+ * FORMULAS
+ *  called = equity * 2 * stack - stack
+ *   Result of an all in called: the pot of both stacks shared by equity.
+ *
+ *  weight * (called - 1) / weights
+ *   Pushing: called instead of winning the big blind, averaged over the
+ *   combos of the big blind compatible with hero.
+ *
+ *  weight * (called + 1)
+ *   Calling instead of folding the big blind, weighted by the combos of the
+ *   small blind compatible with hero.
+ *
+ * @param table        equity table
+ * @param stack        effective stack in big blinds
+ * @param pushMatrix   matrix receiving the pushing payoffs
+ * @param callMatrix   matrix receiving the calling payoffs
+ */
+
+static void fillStackMatrices(const PushFoldTable *table, double stack,
+                              double pushMatrix[][HAND_CLASSES],
+                              double callMatrix[][HAND_CLASSES]) {
+    int hero = 0;
+    int villain = 0;
+
+    for (hero = 0; hero < HAND_CLASSES; hero++) {
+        double weights = 0;
+        for (villain = 0; villain < HAND_CLASSES; villain++) {
+            weights += table->weights[hero][villain];
+        } // endfor
+        for (villain = 0; villain < HAND_CLASSES; villain++) {
+            double called = table->equity[hero][villain] * 2 * stack - stack;
+            pushMatrix[hero][villain] = table->weights[hero][villain] *
+                                        (called - 1) / weights;
+            callMatrix[hero][villain] = table->weights[villain][hero] *
+                                        (called + 1);
+        } // endfor
+    } // endfor
+} // end function
+
+/**
+ * Function calcPushFoldValue
+ * Calculates the small blind result of two strategies, in big blinds.
+ * Folding always results in -0.5.
+ *
+ * @param table        equity table, for the combos of each class
+ * @param pushMatrix   pushing payoffs, see fillStackMatrices()
+ * @param push         pushing frequency of each small blind class
+ * @param call         calling frequency of each big blind class
+ * @return             average result of the small blind
+ */
+
+static double calcPushFoldValue(const PushFoldTable *table,
+                                double pushMatrix[][HAND_CLASSES],
+                                const double push[], const double call[]) {
+    double total = 0;
+    int hero = 0;
+    int villain = 0;
+
+    for (hero = 0; hero < HAND_CLASSES; hero++) {
+        double pushValue = 1;
+        for (villain = 0; villain < HAND_CLASSES; villain++) {
+            pushValue += pushMatrix[hero][villain] * call[villain];
+        } // endfor
+        total += table->comboAmounts[hero] *
+                 (push[hero] * pushValue - (1 - push[hero]) * 0.5);
+    } // endfor
+    return total / HOLE_COMBOS;
+} // end function
+
+/**
+ * Function solvePushFold
+ * Solves the push or fold equilibrium of one stack by fictitious play,
+ * and measures how far it is from an exact equilibrium. The payoffs of
+ * the average strategies are kept as running sums, and the payoffs of the
+ * best responses are only updated for the classes whose response changed,
+ * so a round costs little more than one pass over the classes.
+ *
+ * FORMULAS
+ *  average += (best - average) / (round + 1)
+ *   Running average of the best responses played so far, also applied to
+ *   the payoff sums, as payoffs are linear in the frequencies.
+ *
+ *  exploitability = bestPush - bestCall
+ *   Small blind result of its best response against the average calls,
+ *   minus the one of the average pushes against the big blind's best
+ *   response. It is 0 at an exact equilibrium.
+ *
+ * @param table    equity table
+ * @param result   result with its stack set, receiving the strategies
+ */
+
+void solvePushFold(const PushFoldTable *table, PushFoldResult *result) {
+    double (*pushMatrix)[HAND_CLASSES] = malloc(sizeof(double) *
+                                                HAND_CLASSES * HAND_CLASSES);
+    double (*callMatrix)[HAND_CLASSES] = malloc(sizeof(double) *
+                                                HAND_CLASSES * HAND_CLASSES);
+    double pushSums[HAND_CLASSES] = {};  // Pushing payoff of average calls
+    double callSums[HAND_CLASSES] = {};  // Calling gain of average pushes
+    double pushTerms[HAND_CLASSES] = {}; // Pushing payoff of best calls
+    double callTerms[HAND_CLASSES] = {}; // Calling gain of best pushes
+    double bestPush[HAND_CLASSES] = {};
+    double bestCall[HAND_CLASSES] = {};
+    int round = 0;
+    int hand = 0;
+    int other = 0;
+
+    if (pushMatrix == NULL || callMatrix == NULL) {
+        free(pushMatrix);
+        free(callMatrix);
+        result->exploitability = -1;
+        return;
+    } // endif
+    fillStackMatrices(table, result->stack, pushMatrix, callMatrix);
+    for (hand = 0; hand < HAND_CLASSES; hand++) {
+        result->push[hand] = 1;
+        result->call[hand] = 0;
+        bestPush[hand] = 1;
+    } // endfor
+    for (hand = 0; hand < HAND_CLASSES; hand++) {
+        for (other = 0; other < HAND_CLASSES; other++) {
+            callSums[hand] += callMatrix[hand][other];
+        } // endfor
+        callTerms[hand] = callSums[hand];
+    } // endfor
+
+    for (round = 1; round <= PUSHFOLD_ITERATIONS; round++) {
+        for (hand = 0; hand < HAND_CLASSES; hand++) {
+            double push = (1 + pushSums[hand] > -0.5);
+            double call = (callSums[hand] > 0);
+            if (push != bestPush[hand]) {
+                for (other = 0; other < HAND_CLASSES; other++) {
+                    callTerms[other] += (push - bestPush[hand]) *
+                                        callMatrix[other][hand];
+                } // endfor
+                bestPush[hand] = push;
+            } // endif
+            if (call != bestCall[hand]) {
+                for (other = 0; other < HAND_CLASSES; other++) {
+                    pushTerms[other] += (call - bestCall[hand]) *
+                                        pushMatrix[other][hand];
+                } // endfor
+                bestCall[hand] = call;
+            } // endif
+        } // endfor
+        for (hand = 0; hand < HAND_CLASSES; hand++) {
+            result->push[hand] += (bestPush[hand] - result->push[hand]) /
+                                  (round + 1);
+            result->call[hand] += (bestCall[hand] - result->call[hand]) /
+                                  (round + 1);
+            pushSums[hand] += (pushTerms[hand] - pushSums[hand]) /
+                              (round + 1);
+            callSums[hand] += (callTerms[hand] - callSums[hand]) /
+                              (round + 1);
+        } // endfor
+    } // endfor
+
+    for (hand = 0; hand < HAND_CLASSES; hand++) {
+        bestPush[hand] = (1 + pushSums[hand] > -0.5);
+        bestCall[hand] = (callSums[hand] > 0);
+    } // endfor
+    result->value = calcPushFoldValue(table, pushMatrix, result->push,
+                                      result->call);
+    result->exploitability = calcPushFoldValue(table, pushMatrix, bestPush,
+                                               result->call) -
+                             calcPushFoldValue(table, pushMatrix,
+                                               result->push, bestCall);
+    free(pushMatrix);
+    free(callMatrix);
+} // end function
+
+/**
+ * Function runSweepStacks
+ * Worker thread solving every stack of a sweep whose index matches the
+ * thread.
+ *
+ * @param argument   SolverTask of the thread
+ * @return           NULL
+ */
+
+static void *runSweepStacks(void *argument) {
+    SolverTask *task = argument;
+    int index = 0;
+
+    for (index = task->thread; index < task->resultAmount;
+         index += task->threads) {
+        solvePushFold(task->table, &task->results[index]);
+    } // endfor
+    return NULL;
+} // end function
+
+/**
+ * Function solvePushFoldSweep
+ * Solves several stacks in parallel, all reusing the same equity table.
+ *
+ * @param table          equity table
+ * @param results        results with their stacks set
+ * @param resultAmount   amount of stacks
+ * @param threads        amount of worker threads, up to MAX_THREADS
+ */
+
+void solvePushFoldSweep(const PushFoldTable *table, PushFoldResult results[],
+                        int resultAmount, int threads) {
+    SolverTask task = {};
+
+    task.table = (PushFoldTable *) table;   // Only read by the workers
+    task.results = results;
+    task.resultAmount = resultAmount;
+    runThreads(runSweepStacks, &task, threads);
+} // end function
+
+/**
+ * Function displayChart
+ * Displays a 13 x 13 chart with the largest stack of a sweep at which each
+ * hand class pushes (or calls) more often than not.
+ *
+ * @param results        solved stacks, increasing
+ * @param resultAmount   amount of stacks
+ * @param pushing        TRUE for the pushing chart, FALSE for calling
+ * @param message        header string to print before display
+ */
+
+static void displayChart(const PushFoldResult results[], int resultAmount,
+                         int pushing, wchar_t *message) {
+    int row = 0;
+    int column = 0;
+    int index = 0;
+
+    wprintf(L"%ls\n   ", message);
+    for (column = 0; column < CARD_NUMBERS_AMOUNT; column++) {
+        wprintf(L"%5c", CARD_NUM_SYMBOL[(CARD_NUMBERS_AMOUNT - column) %
+                                        CARD_NUMBERS_AMOUNT]);
+    } // endfor
+    for (row = 0; row < CARD_NUMBERS_AMOUNT; row++) {
+        wprintf(L"\n%3c", CARD_NUM_SYMBOL[(CARD_NUMBERS_AMOUNT - row) %
+                                          CARD_NUMBERS_AMOUNT]);
+        for (column = 0; column < CARD_NUMBERS_AMOUNT; column++) {
+            int hand = row * CARD_NUMBERS_AMOUNT + column;
+            double largest = 0;
+            for (index = 0; index < resultAmount; index++) {
+                double frequency = pushing ? results[index].push[hand] :
+                                             results[index].call[hand];
+                if (frequency >= 0.5) {
+                    largest = results[index].stack;
+                } // endif
+            } // endfor
+            if (largest > 0) {
+                wprintf(L"%5.1f", largest);
+            } // endif
+            else {
+                wprintf(L"    -");
+            } // endelse
+        } // endfor
+    } // endfor
+    wprintf(L"\n\n");
+} // end function
+
+/**
+ * Function displayPushFoldSweep
+ * Displays the ranges, result and exploitability of every stack of a sweep,
+ * followed by the pushing and calling charts. Suited hands are above the
+ * diagonal of the charts and offsuit hands below.
+ *
+ * @param table          equity table, for the combos of each class
+ * @param results        solved stacks, increasing
+ * @param resultAmount   amount of stacks
+ */
+
+void displayPushFoldSweep(const PushFoldTable *table,
+                          const PushFoldResult results[], int resultAmount) {
+    int index = 0;
+    int hand = 0;
+
+    for (index = 0; index < resultAmount; index++) {
+        double pushed = 0;
+        double called = 0;
+        for (hand = 0; hand < HAND_CLASSES; hand++) {
+            pushed += results[index].push[hand] * table->comboAmounts[hand];
+            called += results[index].call[hand] * table->comboAmounts[hand];
+        } // endfor
+        wprintf(L"Stack %5.1f BB - push %5.1f%% - call %5.1f%% - small blind "
+                L"%+.3f BB - exploitability %.4f BB\n", results[index].stack,
+                pushed * 100 / HOLE_COMBOS, called * 100 / HOLE_COMBOS,
+                results[index].value, results[index].exploitability);
+    } // endfor
+    wprintf(L"\n");
+    displayChart(results, resultAmount, TRUE,
+                 L"Small blind: largest stack pushed (BB)");
+    displayChart(results, resultAmount, FALSE,
+                 L"Big blind: largest stack calling (BB)");
+} // end function
@@ -0,0 +1,137 @@
+
+/*---------------------------------------------------------------------------*\
+
+   Source code:  PokerStreets.c
+        Author:  Marcel Riera
+
+   Description:  Source code containing the street by street evaluation
+                 state. A StreetState absorbs cards one at a time (hole
+                 cards, flop, turn and river), keeping the rank mask of each
+                 suit, the ranks held at least once, twice, three and four
+                 times, and the suit of a flush up to date, so evaluating the
+                 turn and river reuses the rank counting of the flop. The
+                 state is a small plain struct, so branching over every
+                 possible next card is a copy and one more card.
+
+                 This file is required for compilation of PokerHands.out, and
+                 must be in the same folder with MainCards.c, CardsValidation.c,
+                 CardsFunctions.c, PokerFunctions.c and Cards.h
+
+\*---------------------------------------------------------------------------*/
+
+#include "Cards.h"      // Required program header
+
+/**
+ * Function initializeStreetState
+ * Empties a street state before the first card.
+ *
+ * @param state   state to empty
+ */
+
+void initializeStreetState(StreetState *state) {
+    int suit = 0;
+
+    for (suit = 0; suit < CARD_TYPE_AMOUNT; suit++) {
+        state->suitRanks[suit] = 0;
+        state->rankCounts[suit] = 0;
+    } // endfor
+    state->flushRanks = 0;
+    state->cards = 0;
+    state->cardAmount = 0;
+} // end function
+
+/**
+ * Function addStreetBit
+ * Absorbs the card at a bit position of a card mask, see getCardMask(). The
+ * rank goes up one count: it joins the first count mask not holding it.
+ *
+ * FORMULAS
+ *  bit / CARD_NUMBERS_AMOUNT and bit % CARD_NUMBERS_AMOUNT
+ *   Suit and rank position of the card, as laid out by getCardMask().
+ *
+ * @param state   state absorbing the card
+ * @param bit     bit position of a card not yet absorbed
+ */
+
+void addStreetBit(StreetState *state, int bit) {
+    int suit = bit / CARD_NUMBERS_AMOUNT;
+    unsigned int rankBit = 1U << (bit % CARD_NUMBERS_AMOUNT);
+    int count = 0;
+
+    state->suitRanks[suit] |= rankBit;
+    while (state->rankCounts[count] & rankBit) {
+        count++;
+    } // endwhile
+    state->rankCounts[count] |= rankBit;
+    if (__builtin_popcount(state->suitRanks[suit]) >= POKER_HAND_SIZE) {
+        state->flushRanks = state->suitRanks[suit];
+    } // endif
+    state->cards |= 1ULL << bit;
+    state->cardAmount++;
+} // end function
+
+/**
+ * Function addStreetCard
+ * Absorbs one card.
+ *
+ * @param state   state absorbing the card
+ * @param card    card not yet absorbed
+ */
+
+void addStreetCard(StreetState *state, Card card) {
+    addStreetBit(state, card.suit * CARD_NUMBERS_AMOUNT +
+                        getHighRank(card.rank));
+} // end function
+
+/**
+ * Function addStreetCards
+ * Absorbs an array of cards, such as a flop.
+ *
+ * @param state        state absorbing the cards
+ * @param cards        cards not yet absorbed
+ * @param cardAmount   amount of cards
+ */
+
+void addStreetCards(StreetState *state, const Card cards[], int cardAmount) {
+    int cardIndex = 0;
+
+    for (cardIndex = 0; cardIndex < cardAmount; cardIndex++) {
+        addStreetCard(state, cards[cardIndex]);
+    } // endfor
+} // end function
+
+/**
+ * Function evaluateStreetState
+ * Evaluates the cards absorbed so far. Without a flush the rank counts
+ * kept by addStreetBit() are evaluated as they are, see evaluateNoFlush();
+ * only flushes go through the suits. With fewer than five cards only
+ * pairs, trips and quads can be found.
+ *
+ * @param state   state to evaluate
+ * @return        comparable hand value
+ */
+
+HandValue evaluateStreetState(const StreetState *state) {
+    if (state->flushRanks) {
+        return evaluateSuits(state->suitRanks);
+    } // endif
+    return evaluateNoFlush(state->rankCounts);
+} // end function
+
+/**
+ * Function evaluateStreetCards
+ * Evaluates an array of cards by absorbing them one at a time into a street
+ * state, to verify the incremental path.
+ *
+ * @param cards        array of cards to evaluate
+ * @param cardAmount   amount of cards, from 5 to MAX_EVAL_CARDS
+ * @return             comparable hand value
+ */
+
+HandValue evaluateStreetCards(const Card cards[], int cardAmount) {
+    StreetState state = {};
+
+    initializeStreetState(&state);
+    addStreetCards(&state, cards, cardAmount);
+    return evaluateStreetState(&state);
+} // end function
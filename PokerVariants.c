@@ -0,0 +1,203 @@
+
+/*---------------------------------------------------------------------------*\
+
+   Source code:  PokerVariants.c
+        Author:  Marcel Riera
+
+   Description:  Source code containing deck and rule variants. A variant
+                 names the ranks in its deck, the evaluator following its
+                 rules and the poker rank of each value class, so the same
+                 dealing, ranking and display functions serve the standard
+                 52 card deck, the 36 card short deck, decks with jokers and
+                 wild cards such as deuces wild. Deal mode can replace the
+                 ranks of any variant with a custom rank list, keeping its
+                 rules.
+
+                 This file is required for compilation of PokerHands.out, and
+                 must be in the same folder with MainCards.c, CardsValidation.c,
+                 CardsFunctions.c, PokerFunctions.c and Cards.h
+
+\*---------------------------------------------------------------------------*/
+
+#include "Cards.h"      // Required program header
+#include <string.h>     // Required for strcmp()
+
+static const DeckVariant DECK_VARIANTS[] = {
+    {"standard", ALL_RANKS, 0, evaluateCards, STANDARD_CLASS_RANKS},
+    {"short", SHORT_DECK_RANKS, 0, evaluateShortDeckCards,
+     SHORT_DECK_CLASS_RANKS},
+    {"joker", ALL_RANKS, 1, evaluateJokerCards, STANDARD_CLASS_RANKS},
+    {"deuces", ALL_RANKS, 0, evaluateDeucesWildCards, STANDARD_CLASS_RANKS}
+};
+
+/**
+ * Function findDeckVariant
+ * Finds a deck variant by its name.
+ *
+ * @param name   name of the variant: "standard", "short", "joker" or
+ *               "deuces"
+ * @return       the variant, or NULL if there is none with that name
+ */
+
+const DeckVariant *findDeckVariant(const char *name) {
+    int index = 0;
+    int variants = sizeof(DECK_VARIANTS) / sizeof(DECK_VARIANTS[0]);
+
+    for (index = 0; index < variants; index++) {
+        if (strcmp(DECK_VARIANTS[index].name, name) == 0) {
+            return &DECK_VARIANTS[index];
+        } // endif
+    } // endfor
+    return NULL;
+} // end function
+
+/**
+ * Function getVariantDeckSize
+ * Calculates the amount of cards in the deck of a variant.
+ *
+ * @param variant   deck variant
+ * @return          amount of cards, 4 per rank in the deck plus jokers
+ */
+
+int getVariantDeckSize(const DeckVariant *variant) {
+    return __builtin_popcount(variant->ranks) * CARD_TYPE_AMOUNT +
+           variant->jokers;
+} // end function
+
+/**
+ * Function initializeVariantDeck
+ * Initializes the deck of a variant in the same order as initializeDeck(),
+ * suit after suit and by rank within each suit, skipping the ranks that
+ * are not in the deck. The jokers go last, told apart by their rank.
+ *
+ * @param deck      array of at least MAX_DECK_SIZE cards to fill
+ * @param variant   deck variant
+ * @return          amount of cards in the deck
+ */
+
+int initializeVariantDeck(Card deck[], const DeckVariant *variant) {
+    int deckSize = 0;
+    int index = 0;
+
+    for (index = 0; index < DECK_SIZE; index++) {
+        Rank rank = index % CARD_NUMBERS_AMOUNT;
+        if (variant->ranks & (1 << rank)) {
+            deck[deckSize].rank = rank;
+            deck[deckSize].suit = index / CARD_NUMBERS_AMOUNT;
+            deckSize++;
+        } // endif
+    } // endfor
+    for (index = 0; index < variant->jokers; index++) {
+        deck[deckSize].rank = index;
+        deck[deckSize].suit = JOKER;
+        deckSize++;
+    } // endfor
+    return deckSize;
+} // end function
+
+/**
+ * Function evaluateShortDeckCards
+ * Evaluates an array of short deck cards in any order.
+ *
+ * FORMULAS
+ *  card.suit * CARD_NUMBERS_AMOUNT + getHighRank(card.rank)
+ *   Bit position of the card, as laid out by getCardMask().
+ *
+ * @param cards        array of cards to evaluate
+ * @param cardAmount   amount of cards, from 5 to MAX_EVAL_CARDS
+ * @return             comparable short deck hand value
+ */
+
+HandValue evaluateShortDeckCards(const Card cards[], int cardAmount) {
+    unsigned int suitRanks[CARD_TYPE_AMOUNT] = {};
+    int cardIndex = 0;
+
+    for (cardIndex = 0; cardIndex < cardAmount; cardIndex++) {
+        suitRanks[cards[cardIndex].suit] |= 1 << getHighRank(
+                                                 cards[cardIndex].rank);
+    } // endfor
+    return evaluateShortDeckSuits(suitRanks);
+} // end function
+
+/**
+ * Function evaluateWildCards
+ * Evaluates an array of cards in any order where jokers, and every card of
+ * the wild ranks, are wild cards. See evaluateWildSuits().
+ *
+ * @param cards        array of cards to evaluate, jokers included
+ * @param cardAmount   amount of cards, from 5 to MAX_EVAL_CARDS
+ * @param wildRanks    ranks that are wild, one bit per Rank
+ * @return             comparable hand value
+ */
+
+HandValue evaluateWildCards(const Card cards[], int cardAmount,
+                            unsigned int wildRanks) {
+    unsigned int suitRanks[CARD_TYPE_AMOUNT] = {};
+    int wilds = 0;
+    int cardIndex = 0;
+
+    for (cardIndex = 0; cardIndex < cardAmount; cardIndex++) {
+        Card card = cards[cardIndex];
+        if (card.suit == JOKER || (wildRanks & (1 << card.rank))) {
+            wilds++;
+        } // endif
+        else {
+            suitRanks[card.suit] |= 1 << getHighRank(card.rank);
+        } // endelse
+    } // endfor
+    return evaluateWildSuits(suitRanks, wilds);
+} // end function
+
+/**
+ * Function evaluateJokerCards
+ * Evaluates an array of cards where only jokers are wild, as in Joker Poker.
+ */
+
+HandValue evaluateJokerCards(const Card cards[], int cardAmount) {
+    return evaluateWildCards(cards, cardAmount, 0);
+} // end function
+
+/**
+ * Function evaluateDeucesWildCards
+ * Evaluates an array of cards where every TWO, and any joker, is wild, as
+ * in Deuces Wild.
+ */
+
+HandValue evaluateDeucesWildCards(const Card cards[], int cardAmount) {
+    return evaluateWildCards(cards, cardAmount, DEUCES_WILD_RANKS);
+} // end function
+
+/**
+ * Function getVariantRank
+ * Extracts the poker rank from a hand value of a variant, whose value
+ * classes may be ordered differently than PokerRank.
+ *
+ * @param value     hand value returned by the variant's evaluator
+ * @param variant   deck variant of the value
+ * @return          poker rank of the hand
+ */
+
+PokerRank getVariantRank(HandValue value, const DeckVariant *variant) {
+    return variant->classRanks[value >> HAND_VALUE_SHIFT];
+} // end function
+
+/**
+ * Function rankVariantHands
+ * Calculates and assigns the value and poker rank of each hand under the
+ * rules of a variant.
+ *
+ * @param hands     array of hands to rank
+ * @param players   amount of players, also the array size
+ * @param variant   deck variant of the hands
+ */
+
+void rankVariantHands(Hand hands[], int players, const DeckVariant *variant) {
+    int playerIndex = 0;
+
+    valueHands(hands, players, variant->evaluator);
+    for (playerIndex = 0; playerIndex < players; playerIndex++) {
+        hands[playerIndex].handRank = getVariantRank(
+                                          hands[playerIndex].handValue,
+                                          variant);
+    } // endfor
+} // end function
@@ -0,0 +1,1178 @@
+
+/*---------------------------------------------------------------------------*\
+
+   Source code:  PokerVerification.c
+        Author:  Marcel Riera
+
+   Description:  Source code containing a differential verification harness.
+                 Any evaluator following the ValueEvaluator signature is
+                 compared against calcReferenceValue(), whose poker ranks
+                 come from the reference cascade of calcPokerRank() and
+                 whose kickers come from counting ranks, exhaustively over
+                 all five card hands and by random sampling for larger
+                 hands, reporting the first mismatching hand.
+                 Low evaluators, which the cascade cannot judge, are compared
+                 against a rank counting reference instead.
+
+                 This file is required for compilation of PokerHands.out, and
+                 must be in the same folder with MainCards.c, CardsValidation.c,
+                 CardsFunctions.c, PokerFunctions.c and Cards.h
+
+\*---------------------------------------------------------------------------*/
+
+#include "Cards.h"      // Required program header
+#include <string.h>     // Required for strcmp()
+
+#define VERIFY_CACHE_SLOTS 256  // Small cache, so entries get replaced
+#define VERIFY_CACHE_POOL 10    // Cards the hands of one deck come from
+#define VERIFY_CACHE_REUSE 1000 // Hands dealt before shuffling again
+#define VERIFY_POT_CHIPS 1000   // Largest random pot split by splitPot()
+#define VERIFY_SPLIT_VALUES 3   // Random values per player, so ties happen
+#define VERIFY_ISO_DEALS 8      // Random hole cards for canonical boards
+#define VERIFY_AUDIT_RECORDS 3  // Short records audited for their echo
+#define VERIFY_AUDIT_REPORT 512 // Bytes of the expected audit report
+
+static HandValue calcLowReference(const Card cards[], int cardAmount,
+                                  int aceHigh, int straights, int qualifier);
+static HandValue calcPatternBadness(const Card cards[], int aceHigh,
+                                    int straights);
+
+/**
+ * Function calcReferenceRank
+ * Calculates the poker rank of any amount of cards with the reference
+ * cascade, by sorting and ranking every five card combination and keeping
+ * the best one.
+ *
+ * @param cards        array of cards to rank, in any order
+ * @param cardAmount   amount of cards, from 5 to MAX_EVAL_CARDS
+ * @return             best poker rank among all five card combinations
+ */
+
+PokerRank calcReferenceRank(const Card cards[], int cardAmount) {
+    PokerRank bestRank = HIGH_CARD;
+    int indexes[POKER_HAND_SIZE] = {};
+    int handIndex = 0;
+
+    firstCombination(indexes, POKER_HAND_SIZE);
+    do {
+        Hand hand = {};
+        PokerRank rank = 0;
+
+        for (handIndex = 0; handIndex < POKER_HAND_SIZE; handIndex++) {
+            hand.cards[handIndex] = cards[indexes[handIndex]];
+        } // endfor
+        sortHands(&hand, 1);
+        rank = calcPokerRank(hand);
+        if (rank > bestRank) {
+            bestRank = rank;
+        } // endif
+    } while (nextCombination(indexes, POKER_HAND_SIZE, cardAmount));
+    return bestRank;
+} // end function
+
+/**
+ * Function calcReferenceValue
+ * Calculates the full value of any amount of cards without the lookup
+ * tables: the poker rank of every five card combination comes from the
+ * reference cascade, and its kickers from counting ranks as in
+ * calcPatternBadness(), keeping the best combination.
+ *
+ * FORMULAS
+ *  high << 16
+ *   Straights are decided by their high card only, FIVE for the wheel.
+ *
+ * @param cards        array of cards to evaluate, in any order
+ * @param cardAmount   amount of cards, from 5 to MAX_EVAL_CARDS
+ * @return             best hand value among all five card combinations
+ */
+
+HandValue calcReferenceValue(const Card cards[], int cardAmount) {
+    HandValue bestValue = 0;
+    int indexes[POKER_HAND_SIZE] = {};
+    int handIndex = 0;
+
+    firstCombination(indexes, POKER_HAND_SIZE);
+    do {
+        Hand hand = {};
+        PokerRank rank = 0;
+        HandValue kickers = 0;
+        unsigned int ranks = 0;
+
+        for (handIndex = 0; handIndex < POKER_HAND_SIZE; handIndex++) {
+            hand.cards[handIndex] = cards[indexes[handIndex]];
+            ranks |= 1 << getHighRank(hand.cards[handIndex].rank);
+        } // endfor
+        sortHands(&hand, 1);
+        rank = calcPokerRank(hand);
+        kickers = calcPatternBadness(hand.cards, TRUE, FALSE) &
+                  ((1 << HAND_VALUE_SHIFT) - 1);
+        if (rank == STRAIGHT || rank == STRAIGHT_FLUSH) {
+            int high = 31 - __builtin_clz(ranks);
+            if ((ranks & (1 << getHighRank(ACE))) &&
+                (ranks & (1 << getHighRank(TWO)))) {
+                high = getHighRank(FIVE);   // Wheel, A-2-3-4-5
+            } // endif
+            kickers = high << 16;
+        } // endif
+        if (((HandValue) rank << HAND_VALUE_SHIFT | kickers) > bestValue) {
+            bestValue = (HandValue) rank << HAND_VALUE_SHIFT | kickers;
+        } // endif
+    } while (nextCombination(indexes, POKER_HAND_SIZE, cardAmount));
+    return bestValue;
+} // end function
+
+/**
+ * Function recordMismatch
+ * Stores the first mismatching hand found into a verification result.
+ *
+ * @param result       result to store the hand in
+ * @param cards        mismatching cards
+ * @param cardAmount   amount of cards
+ * @param expected     rank given by the reference
+ * @param found        rank given by the evaluator
+ */
+
+static void recordMismatch(VerifyResult *result, const Card cards[],
+                           int cardAmount, PokerRank expected,
+                           PokerRank found) {
+    int cardIndex = 0;
+
+    result->mismatch = TRUE;
+    result->cardAmount = cardAmount;
+    result->expected = expected;
+    result->found = found;
+    result->expectedValue = 0;
+    result->foundValue = 0;
+    for (cardIndex = 0; cardIndex < cardAmount; cardIndex++) {
+        result->cards[cardIndex] = cards[cardIndex];
+    } // endfor
+} // end function
+
+/**
+ * Function verifyExhaustive
+ * Compares the values of an evaluator against calcReferenceValue() for all
+ * 2,598,960 five card hands, stopping at the first mismatch.
+ * NOTE: the evaluator receives the cards unsorted, in deck order.
+ *
+ * @param evaluator   evaluator to verify
+ * @param result      verification result to fill
+ */
+
+void verifyExhaustive(ValueEvaluator evaluator, VerifyResult *result) {
+    Card deck[DECK_SIZE] = {};
+    int c1 = 0, c2 = 0, c3 = 0, c4 = 0, c5 = 0;
+
+    initializeDeck(deck);
+    result->checked = 0;
+    result->mismatch = FALSE;
+    for (c1 = 0; c1 < DECK_SIZE; c1++) {
+    for (c2 = c1 + 1; c2 < DECK_SIZE; c2++) {
+    for (c3 = c2 + 1; c3 < DECK_SIZE; c3++) {
+    for (c4 = c3 + 1; c4 < DECK_SIZE; c4++) {
+    for (c5 = c4 + 1; c5 < DECK_SIZE; c5++) {
+        Card cards[] = {deck[c1], deck[c2], deck[c3], deck[c4], deck[c5]};
+        HandValue found = evaluator(cards, POKER_HAND_SIZE);
+        HandValue expected = calcReferenceValue(cards, POKER_HAND_SIZE);
+
+        result->checked++;
+        if (found != expected) {
+            recordMismatch(result, cards, POKER_HAND_SIZE,
+                           getValueRank(expected), getValueRank(found));
+            result->expectedValue = expected;
+            result->foundValue = found;
+            return;
+        } // endif
+    } // endfor
+    } // endfor
+    } // endfor
+    } // endfor
+    } // endfor
+} // end function
+
+/**
+ * Function verifySampled
+ * Compares the values of an evaluator against calcReferenceValue() for
+ * random hands of a given size, dealt from freshly shuffled decks, stopping
+ * at the first mismatch.
+ *
+ * @param evaluator    evaluator to verify
+ * @param cardAmount   size of the random hands, up to MAX_EVAL_CARDS
+ * @param samples      amount of random hands to compare
+ * @param result       verification result to fill
+ */
+
+void verifySampled(ValueEvaluator evaluator, int cardAmount, long samples,
+                   VerifyResult *result) {
+    Card deck[DECK_SIZE] = {};
+    long sample = 0;
+
+    initializeDeck(deck);
+    result->checked = 0;
+    result->mismatch = FALSE;
+    for (sample = 0; sample < samples; sample++) {
+        HandValue found = 0;
+        HandValue expected = 0;
+
+        shuffleDeck(deck);
+        found = evaluator(deck, cardAmount);
+        expected = calcReferenceValue(deck, cardAmount);
+        result->checked++;
+        if (found != expected) {
+            recordMismatch(result, deck, cardAmount, getValueRank(expected),
+                           getValueRank(found));
+            result->expectedValue = expected;
+            result->foundValue = found;
+            return;
+        } // endif
+    } // endfor
+} // end function
+
+/**
+ * Function calcOmahaReferenceRank
+ * Calculates the poker rank of an Omaha hand with the reference cascade,
+ * trying every two hole card and three board card combination.
+ *
+ * @param hole          hole cards of the player
+ * @param holeAmount    amount of hole cards
+ * @param board         board cards, BOARD_SIZE of them
+ * @return              best poker rank among all combinations
+ */
+
+static PokerRank calcOmahaReferenceRank(const Card hole[], int holeAmount,
+                                        const Card board[]) {
+    PokerRank bestRank = HIGH_CARD;
+    int h1 = 0, h2 = 0, b1 = 0, b2 = 0, b3 = 0;
+
+    for (h1 = 0; h1 < holeAmount; h1++) {
+    for (h2 = h1 + 1; h2 < holeAmount; h2++) {
+    for (b1 = 0; b1 < BOARD_SIZE; b1++) {
+    for (b2 = b1 + 1; b2 < BOARD_SIZE; b2++) {
+    for (b3 = b2 + 1; b3 < BOARD_SIZE; b3++) {
+        Card cards[] = {hole[h1], hole[h2], board[b1], board[b2], board[b3]};
+        PokerRank rank = calcReferenceRank(cards, POKER_HAND_SIZE);
+        if (rank > bestRank) {
+            bestRank = rank;
+        } // endif
+    } // endfor
+    } // endfor
+    } // endfor
+    } // endfor
+    } // endfor
+    return bestRank;
+} // end function
+
+/**
+ * Function calcOmahaLowReference
+ * Calculates the eight or better low of an Omaha hand by trying every two
+ * hole card and three board card combination with calcLowReference().
+ *
+ * @param hole          hole cards of the player
+ * @param holeAmount    amount of hole cards
+ * @param board         board cards, BOARD_SIZE of them
+ * @return              comparable low value, NO_LOW if none qualifies
+ */
+
+static HandValue calcOmahaLowReference(const Card hole[], int holeAmount,
+                                       const Card board[]) {
+    HandValue bestValue = NO_LOW;
+    int h1 = 0, h2 = 0, b1 = 0, b2 = 0, b3 = 0;
+
+    for (h1 = 0; h1 < holeAmount; h1++) {
+    for (h2 = h1 + 1; h2 < holeAmount; h2++) {
+    for (b1 = 0; b1 < BOARD_SIZE; b1++) {
+    for (b2 = b1 + 1; b2 < BOARD_SIZE; b2++) {
+    for (b3 = b2 + 1; b3 < BOARD_SIZE; b3++) {
+        Card cards[] = {hole[h1], hole[h2], board[b1], board[b2], board[b3]};
+        HandValue value = calcLowReference(cards, POKER_HAND_SIZE, FALSE,
+                                           FALSE, TRUE);
+        if (value > bestValue) {
+            bestValue = value;
+        } // endif
+    } // endfor
+    } // endfor
+    } // endfor
+    } // endfor
+    } // endfor
+    return bestValue;
+} // end function
+
+/**
+ * Function verifyOmaha
+ * Compares evaluateOmaha() against the reference cascade and against every
+ * combination evaluated by evaluateOmahaNaive(), and evaluateOmahaLow()
+ * against calcOmahaLowReference(), for random deals of one player and a
+ * complete board, stopping at the first mismatch.
+ * NOTE: the deal is stored hole cards first, followed by the board.
+ *
+ * @param holeAmount   OMAHA_HOLE_SIZE or PLO5_HOLE_SIZE
+ * @param samples      amount of random deals to compare
+ * @param result       verification result to fill
+ */
+
+void verifyOmaha(int holeAmount, long samples, VerifyResult *result) {
+    Card deck[DECK_SIZE] = {};
+    long sample = 0;
+
+    initializeDeck(deck);
+    result->checked = 0;
+    result->mismatch = FALSE;
+    for (sample = 0; sample < samples; sample++) {
+        const Card *board = deck + holeAmount;
+        OmahaBoard prepared = {};
+        HandValue found = 0;
+        HandValue naive = 0;
+        PokerRank expected = 0;
+
+        shuffleDeck(deck);
+        prepareOmahaBoard(board, BOARD_SIZE, &prepared);
+        found = evaluateOmaha(deck, holeAmount, &prepared);
+        naive = evaluateOmahaNaive(deck, holeAmount, board, BOARD_SIZE);
+        expected = calcOmahaReferenceRank(deck, holeAmount, board);
+        result->checked++;
+        if (found != naive || getValueRank(found) != expected) {
+            recordMismatch(result, deck, holeAmount + BOARD_SIZE, expected,
+                           getValueRank(found));
+            return;
+        } // endif
+        found = evaluateOmahaLow(deck, holeAmount, board, BOARD_SIZE);
+        naive = calcOmahaLowReference(deck, holeAmount, board);
+        if (found != naive) {
+            recordMismatch(result, deck, holeAmount + BOARD_SIZE, HIGH_CARD,
+                           HIGH_CARD);
+            result->expectedValue = naive;
+            result->foundValue = found;
+            return;
+        } // endif
+    } // endfor
+} // end function
+
+/**
+ * Function calcPatternBadness
+ * Calculates the value of exactly five cards as a high hand by counting
+ * ranks, independently of the lookup tables, for the low references.
+ *
+ * FORMULAS
+ *  maxRank - minRank == 4
+ *   Five different ranks are a straight when they span exactly five ranks.
+ *
+ * @param cards       five cards to evaluate
+ * @param aceHigh     TRUE to rank aces above kings, FALSE to rank them low
+ * @param straights   TRUE if straights and flushes count
+ * @return            value of the cards as a high hand
+ */
+
+static HandValue calcPatternBadness(const Card cards[], int aceHigh,
+                                    int straights) {
+    int counts[CARD_NUMBERS_AMOUNT] = {};
+    int groups[POKER_HAND_SIZE] = {};
+    unsigned int packed = 0;
+    int minRank = CARD_NUMBERS_AMOUNT;
+    int maxRank = 0;
+    int flush = TRUE;
+    int cardIndex = 0;
+    int count = 0;
+    int rank = 0;
+    PokerRank pokerRank = HIGH_CARD;
+
+    for (cardIndex = 0; cardIndex < POKER_HAND_SIZE; cardIndex++) {
+        rank = aceHigh ? getHighRank(cards[cardIndex].rank) :
+                         (int) cards[cardIndex].rank;
+        counts[rank]++;
+        minRank = (rank < minRank) ? rank : minRank;
+        maxRank = (rank > maxRank) ? rank : maxRank;
+        flush &= (cards[cardIndex].suit == cards[FIRST_CARD].suit);
+    } // endfor
+
+    // Ranks packed by group size first, then by rank
+    for (count = CARD_TYPE_AMOUNT; count > 0; count--) {
+        for (rank = CARD_NUMBERS_AMOUNT - 1; rank >= 0; rank--) {
+            if (counts[rank] == count) {
+                packed = (packed << KICKER_BITS) | rank;
+                groups[count]++;
+            } // endif
+        } // endfor
+    } // endfor
+    packed <<= KICKER_BITS * (POKER_HAND_SIZE - groups[1] - groups[2] -
+                              groups[3] - groups[4]);
+
+    if (groups[4]) {
+        pokerRank = FOUR_OF_A_KIND;
+    } // endif
+    else if (groups[3] && groups[2]) {
+        pokerRank = FULL_HOUSE;
+    } // endif
+    else if (groups[3]) {
+        pokerRank = THREE_OF_A_KIND;
+    } // endif
+    else if (groups[2] == 2) {
+        pokerRank = TWO_PAIRS;
+    } // endif
+    else if (groups[2]) {
+        pokerRank = ONE_PAIR;
+    } // endif
+    else if (straights && maxRank - minRank == 4) {
+        pokerRank = flush ? STRAIGHT_FLUSH : STRAIGHT;
+        packed = maxRank << 16;
+    } // endif
+    else if (straights && flush) {
+        pokerRank = FLUSH;
+    } // endif
+    return ((HandValue) pokerRank << HAND_VALUE_SHIFT) | packed;
+} // end function
+
+/**
+ * Function calcLowReference
+ * Calculates a low value by judging every five card combination with
+ * calcPatternBadness() and keeping the lowest.
+ *
+ * @param cards        cards of the hand
+ * @param cardAmount   amount of cards, from 5 to MAX_EVAL_CARDS
+ * @param aceHigh      TRUE to rank aces above kings, FALSE to rank them low
+ * @param straights    TRUE if straights and flushes count
+ * @param qualifier    TRUE to require five different ranks up to EIGHT
+ * @return             comparable low value, NO_LOW if none qualifies
+ */
+
+static HandValue calcLowReference(const Card cards[], int cardAmount,
+                                  int aceHigh, int straights, int qualifier) {
+    HandValue bestBadness = LOW_VALUE_LIMIT;
+    int indexes[POKER_HAND_SIZE] = {};
+    int handIndex = 0;
+
+    firstCombination(indexes, POKER_HAND_SIZE);
+    do {
+        Card hand[POKER_HAND_SIZE] = {};
+        HandValue badness = 0;
+        int qualifies = TRUE;
+
+        for (handIndex = 0; handIndex < POKER_HAND_SIZE; handIndex++) {
+            hand[handIndex] = cards[indexes[handIndex]];
+            qualifies &= (hand[handIndex].rank <= EIGHT);
+        } // endfor
+        badness = calcPatternBadness(hand, aceHigh, straights);
+        qualifies &= (getValueRank(badness) == HIGH_CARD);
+        if ((qualifies || !qualifier) && badness < bestBadness) {
+            bestBadness = badness;
+        } // endif
+    } while (nextCombination(indexes, POKER_HAND_SIZE, cardAmount));
+    return (bestBadness == LOW_VALUE_LIMIT) ? NO_LOW :
+                                              LOW_VALUE_LIMIT - bestBadness;
+} // end function
+
+/**
+ * Function calcAceToFiveReference
+ * Reference for evaluateAceToFive().
+ */
+
+static HandValue calcAceToFiveReference(const Card cards[], int cardAmount) {
+    return calcLowReference(cards, cardAmount, FALSE, FALSE, FALSE);
+} // end function
+
+/**
+ * Function calcEightOrBetterReference
+ * Reference for evaluateEightOrBetter().
+ */
+
+static HandValue calcEightOrBetterReference(const Card cards[],
+                                            int cardAmount) {
+    return calcLowReference(cards, cardAmount, FALSE, FALSE, TRUE);
+} // end function
+
+/**
+ * Function calcDeuceToSevenReference
+ * Reference for evaluateDeuceToSeven().
+ */
+
+static HandValue calcDeuceToSevenReference(const Card cards[],
+                                           int cardAmount) {
+    return calcLowReference(cards, cardAmount, TRUE, TRUE, FALSE);
+} // end function
+
+/**
+ * Function calcShortDeckBadness
+ * Calculates the short deck value of exactly five cards from the standard
+ * pattern value: A-6-7-8-9 becomes a straight, and flushes and full houses
+ * swap their value classes.
+ *
+ * @param cards   five short deck cards
+ * @return        comparable short deck hand value
+ */
+
+static HandValue calcShortDeckBadness(const Card cards[]) {
+    HandValue value = calcPatternBadness(cards, TRUE, TRUE);
+    PokerRank rank = getValueRank(value);
+    unsigned int ranks = 0;
+    int cardIndex = 0;
+
+    for (cardIndex = 0; cardIndex < POKER_HAND_SIZE; cardIndex++) {
+        ranks |= 1 << cards[cardIndex].rank;
+    } // endfor
+    if (ranks == ((1 << ACE) | (1 << SIX) | (1 << SEVEN) | (1 << EIGHT) |
+                  (1 << NINE))) {
+        rank = (rank == FLUSH) ? STRAIGHT_FLUSH : STRAIGHT;
+        return ((HandValue) rank << HAND_VALUE_SHIFT) |
+               (getHighRank(NINE) << 16);
+    } // endif
+    if (rank == FLUSH || rank == FULL_HOUSE) {
+        rank = (rank == FLUSH) ? FULL_HOUSE : FLUSH;
+        value = (value & ((1 << HAND_VALUE_SHIFT) - 1)) |
+                ((HandValue) rank << HAND_VALUE_SHIFT);
+    } // endif
+    return value;
+} // end function
+
+/**
+ * Function calcShortDeckReference
+ * Reference for evaluateShortDeckCards(), keeping the best five card
+ * combination judged by calcShortDeckBadness().
+ */
+
+static HandValue calcShortDeckReference(const Card cards[], int cardAmount) {
+    HandValue bestValue = 0;
+    int indexes[POKER_HAND_SIZE] = {};
+    int handIndex = 0;
+
+    firstCombination(indexes, POKER_HAND_SIZE);
+    do {
+        Card hand[POKER_HAND_SIZE] = {};
+        HandValue value = 0;
+
+        for (handIndex = 0; handIndex < POKER_HAND_SIZE; handIndex++) {
+            hand[handIndex] = cards[indexes[handIndex]];
+        } // endfor
+        value = calcShortDeckBadness(hand);
+        if (value > bestValue) {
+            bestValue = value;
+        } // endif
+    } while (nextCombination(indexes, POKER_HAND_SIZE, cardAmount));
+    return bestValue;
+} // end function
+
+/**
+ * Function calcWildReference
+ * Reference for evaluateWildCards(), trying every substitution of the wild
+ * cards by cards not in the hand with evaluateMask(). Five of a kind needs a
+ * card already in the hand, so it is checked first by counting ranks.
+ *
+ * @param cards        array of cards, jokers included
+ * @param cardAmount   amount of cards, from 5 to MAX_EVAL_CARDS
+ * @param wildRanks    ranks that are wild, one bit per Rank
+ * @return             best hand value of any substitution
+ */
+
+static HandValue calcWildReference(const Card cards[], int cardAmount,
+                                   unsigned int wildRanks) {
+    int rankCounts[CARD_NUMBERS_AMOUNT] = {};
+    int unseen[DECK_SIZE] = {};
+    int indexes[MAX_EVAL_CARDS] = {};
+    CardMask naturals = 0;
+    HandValue bestValue = 0;
+    int unseenAmount = 0;
+    int wilds = 0;
+    int index = 0;
+
+    for (index = 0; index < cardAmount; index++) {
+        if (cards[index].suit == JOKER ||
+            (wildRanks & (1 << cards[index].rank))) {
+            wilds++;
+        } // endif
+        else {
+            naturals |= getCardMask(cards[index]);
+            rankCounts[getHighRank(cards[index].rank)]++;
+        } // endelse
+    } // endfor
+    for (index = CARD_NUMBERS_AMOUNT - 1; index >= 0; index--) {
+        if (rankCounts[index] + wilds >= POKER_HAND_SIZE) {
+            return ((HandValue) FIVE_OF_A_KIND << HAND_VALUE_SHIFT) |
+                   (index << 16);
+        } // endif
+    } // endfor
+    if (wilds == 0) {
+        return evaluateMask(naturals);
+    } // endif
+
+    for (index = 0; index < DECK_SIZE; index++) {
+        if (!(naturals & (1ULL << index))) {
+            unseen[unseenAmount] = index;
+            unseenAmount++;
+        } // endif
+    } // endfor
+    firstCombination(indexes, wilds);
+    do {
+        CardMask mask = naturals;
+        HandValue value = 0;
+
+        for (index = 0; index < wilds; index++) {
+            mask |= 1ULL << unseen[indexes[index]];
+        } // endfor
+        value = evaluateMask(mask);
+        if (value > bestValue) {
+            bestValue = value;
+        } // endif
+    } while (nextCombination(indexes, wilds, unseenAmount));
+    return bestValue;
+} // end function
+
+/**
+ * Function calcJokerReference
+ * Reference for evaluateJokerCards().
+ */
+
+static HandValue calcJokerReference(const Card cards[], int cardAmount) {
+    return calcWildReference(cards, cardAmount, 0);
+} // end function
+
+/**
+ * Function calcDeucesWildReference
+ * Reference for evaluateDeucesWildCards().
+ */
+
+static HandValue calcDeucesWildReference(const Card cards[],
+                                         int cardAmount) {
+    return calcWildReference(cards, cardAmount, DEUCES_WILD_RANKS);
+} // end function
+
+/**
+ * Function verifyValues
+ * Compares a value evaluator against a reference value evaluator for
+ * random hands of a given size dealt from the deck of a variant, stopping
+ * at the first mismatch.
+ *
+ * @param evaluator    evaluator to verify
+ * @param reference    reference evaluator
+ * @param variant      deck variant to deal from
+ * @param cardAmount   size of the random hands, up to MAX_EVAL_CARDS
+ * @param samples      amount of random hands to compare
+ * @param result       verification result to fill
+ */
+
+void verifyValues(ValueEvaluator evaluator, ValueEvaluator reference,
+                  const DeckVariant *variant, int cardAmount, long samples,
+                  VerifyResult *result) {
+    Card deck[MAX_DECK_SIZE] = {};
+    int deckSize = initializeVariantDeck(deck, variant);
+    long sample = 0;
+
+    result->checked = 0;
+    result->mismatch = FALSE;
+    for (sample = 0; sample < samples; sample++) {
+        HandValue found = 0;
+        HandValue expected = 0;
+
+        shuffleCards(deck, deckSize);
+        found = evaluator(deck, cardAmount);
+        expected = reference(deck, cardAmount);
+        result->checked++;
+        if (found != expected) {
+            recordMismatch(result, deck, cardAmount, HIGH_CARD, HIGH_CARD);
+            result->expectedValue = expected;
+            result->foundValue = found;
+            return;
+        } // endif
+    } // endfor
+} // end function
+
+/**
+ * Function verifyEvalCache
+ * Checks evaluateMaskCached() against evaluateMask(). Hands repeat, as they
+ * are drawn from the first VERIFY_CACHE_POOL cards of a deck shuffled
+ * every VERIFY_CACHE_REUSE hands, and the cache is small, so hits and
+ * replaced entries are both checked.
+ *
+ * @param samples   amount of random hands to check
+ * @param result    verification result to fill
+ */
+
+void verifyEvalCache(long samples, VerifyResult *result) {
+    Card deck[DECK_SIZE] = {};
+    EvalCache cache = {};
+    long sample = 0;
+
+    initializeDeck(deck);
+    result->checked = 0;
+    result->mismatch = FALSE;
+    if (!createEvalCache(&cache, VERIFY_CACHE_SLOTS)) {
+        result->mismatch = TRUE;
+        return;
+    } // endif
+    for (sample = 0; sample < samples; sample++) {
+        CardMask mask = 0;
+
+        if (sample % VERIFY_CACHE_REUSE == 0) {
+            shuffleDeck(deck);
+        } // endif
+        drawRandomCards(deck, VERIFY_CACHE_POOL, MAX_EVAL_CARDS);
+        mask = cardsToMask(deck, MAX_EVAL_CARDS);
+        result->checked++;
+        if (evaluateMaskCached(&cache, mask) != evaluateMask(mask)) {
+            recordMismatch(result, deck, MAX_EVAL_CARDS, HIGH_CARD,
+                           HIGH_CARD);
+            break;
+        } // endif
+    } // endfor
+    freeEvalCache(&cache);
+} // end function
+
+/**
+ * Function verifyAuditEcho
+ * Checks that auditRecord() escapes the log bytes it echoes: a record
+ * with a wrong winner and an id that is not ASCII, a correct record, an
+ * unreadable record that is not ASCII and one longer than AUDIT_ECHO_LEN
+ * must give exactly the expected report, which prints on a wide stream.
+ *
+ * @param result    verification result to fill, counting records
+ */
+
+void verifyAuditEcho(VerifyResult *result) {
+    const char *records[VERIFY_AUDIT_RECORDS] = {
+        "h\xE9;AhKhQhJh2c;ThTc 3d4d;2", "1;AhKhQhJh2c;ThTc 3d4d;1",
+        "bad\xE9record"};
+    char longRecord[2 * AUDIT_ECHO_LEN] = {};
+    char expected[VERIFY_AUDIT_REPORT] = {};
+    AuditChunk chunk = {};
+    int length = 0;
+    int record = 0;
+    int index = 0;
+
+    result->checked = 0;
+    length = sprintf(expected, "Hand h\\xE9 - recorded 2, evaluated 1 "
+                     "with Straight Flush\nInvalid record: bad\\xE9record"
+                     "\nInvalid record: ");
+    for (index = 0; index < AUDIT_ECHO_LEN; index++) {
+        length += sprintf(expected + length, "\\xE9");
+    } // endfor
+    sprintf(expected + length, "\n");
+
+    for (record = 0; record < VERIFY_AUDIT_RECORDS; record++) {
+        auditRecord(&chunk, NULL, records[record],
+                    records[record] + strlen(records[record]));
+        result->checked++;
+    } // endfor
+    for (index = 0; index < 2 * AUDIT_ECHO_LEN; index++) {
+        longRecord[index] = (char) 0xE9;
+    } // endfor
+    auditRecord(&chunk, NULL, longRecord, longRecord + 2 * AUDIT_ECHO_LEN);
+    result->checked++;
+
+    result->mismatch = (chunk.report == NULL ||
+                        strcmp(chunk.report, expected) != 0 ||
+                        chunk.records != 2 || chunk.mismatches != 1 ||
+                        chunk.invalid != 2);
+    free(chunk.report);
+} // end function
+
+/**
+ * Function calcSplitReference
+ * Reference for splitPot(), handing out the chips of each half of the pot
+ * one at a time to its winners, going around the seats from the first.
+ *
+ * @param high      high value of each player
+ * @param low       low value of each player, NO_LOW if it does not qualify
+ * @param players   amount of players, also the arrays size
+ * @param pot       chips in the pot
+ * @param shares    array receiving each player's chips
+ */
+
+static void calcSplitReference(const HandValue high[], const HandValue low[],
+                               int players, long pot, long shares[]) {
+    HandValue bestHigh = 0;
+    HandValue bestLow = NO_LOW;
+    long highChips = pot;
+    long lowChips = 0;
+    int seat = 0;
+
+    for (seat = 0; seat < players; seat++) {
+        bestHigh = (high[seat] > bestHigh) ? high[seat] : bestHigh;
+        bestLow = (low[seat] > bestLow) ? low[seat] : bestLow;
+        shares[seat] = 0;
+    } // endfor
+    if (bestLow != NO_LOW) {
+        lowChips = pot / 2;
+        highChips = pot - lowChips;
+    } // endif
+    for (seat = 0; highChips > 0; seat = (seat + 1) % players) {
+        if (high[seat] == bestHigh) {
+            shares[seat]++;
+            highChips--;
+        } // endif
+    } // endfor
+    for (seat = 0; lowChips > 0; seat = (seat + 1) % players) {
+        if (low[seat] == bestLow) {
+            shares[seat]++;
+            lowChips--;
+        } // endif
+    } // endfor
+} // end function
+
+/**
+ * Function verifySplitPot
+ * Compares splitPot() against calcSplitReference() for random pots and
+ * random high and low values drawn from a few values, so ties between
+ * several players and pots without a low are frequent.
+ *
+ * @param samples   amount of random pots to compare
+ * @param result    verification result to fill, with the chips of the
+ *                  first mismatching player as values
+ */
+
+void verifySplitPot(long samples, VerifyResult *result) {
+    long sample = 0;
+
+    result->checked = 0;
+    result->mismatch = FALSE;
+    for (sample = 0; sample < samples; sample++) {
+        HandValue high[MAX_PLAYERS] = {};
+        HandValue low[MAX_PLAYERS] = {};
+        long found[MAX_PLAYERS] = {};
+        long expected[MAX_PLAYERS] = {};
+        int players = 2 + rand() % (MAX_PLAYERS - 1);
+        long pot = 1 + rand() % VERIFY_POT_CHIPS;
+        int seat = 0;
+
+        for (seat = 0; seat < players; seat++) {
+            high[seat] = 1 + rand() % VERIFY_SPLIT_VALUES;
+            low[seat] = rand() % VERIFY_SPLIT_VALUES;   // 0 is NO_LOW
+        } // endfor
+        splitPot(high, low, players, pot, found);
+        calcSplitReference(high, low, players, pot, expected);
+        result->checked++;
+        for (seat = 0; seat < players; seat++) {
+            if (found[seat] != expected[seat]) {
+                recordMismatch(result, NULL, 0, HIGH_CARD, HIGH_CARD);
+                result->expectedValue = expected[seat];
+                result->foundValue = found[seat];
+                return;
+            } // endif
+        } // endfor
+    } // endfor
+} // end function
+
+/**
+ * Function verifyIsomorphism
+ * Checks canonicalizeGroups() on random hole and board groups: a random suit
+ * permutation of the groups must have the same canonical groups, and the
+ * canonical groups must evaluate as the original ones.
+ *
+ * @param samples   amount of random deals to check
+ * @param result    verification result to fill
+ */
+
+void verifyIsomorphism(long samples, VerifyResult *result) {
+    Card deck[DECK_SIZE] = {};
+    long sample = 0;
+
+    initializeDeck(deck);
+    result->checked = 0;
+    result->mismatch = FALSE;
+    for (sample = 0; sample < samples; sample++) {
+        CardMask groups[2] = {};
+        CardMask shuffled[2] = {};
+        CardMask canonical[2] = {};
+        CardMask again[2] = {};
+        int suits[CARD_TYPE_AMOUNT] = {HEART, DIAMOND, CLUBS, SPADES};
+        int permutation[CARD_TYPE_AMOUNT] = {};
+        int suit = 0;
+
+        shuffleDeck(deck);
+        for (suit = CARD_TYPE_AMOUNT - 1; suit > 0; suit--) {
+            int other = rand() % (suit + 1);
+            int tmp = suits[suit];
+            suits[suit] = suits[other];
+            suits[other] = tmp;
+        } // endfor
+        groups[0] = cardsToMask(deck, OMAHA_HOLE_USED);
+        groups[1] = cardsToMask(deck + OMAHA_HOLE_USED, BOARD_SIZE);
+        shuffled[0] = permuteSuits(groups[0], suits);
+        shuffled[1] = permuteSuits(groups[1], suits);
+        canonicalizeGroups(groups, 2, canonical, permutation);
+        canonicalizeGroups(shuffled, 2, again, permutation);
+        result->checked++;
+        if (canonical[0] != again[0] || canonical[1] != again[1] ||
+            evaluateMask(canonical[0] | canonical[1]) !=
+            evaluateMask(groups[0] | groups[1])) {
+            recordMismatch(result, deck, OMAHA_HOLE_USED + BOARD_SIZE,
+                           HIGH_CARD, HIGH_CARD);
+            return;
+        } // endif
+    } // endfor
+} // end function
+
+/**
+ * Function verifyCanonicalBoards
+ * Checks enumerateCanonicalBoards() on random hole cards of 0 to 4 cards
+ * and flop or turn boards. The value of each canonical class is evaluated
+ * once and cached by its slot; then every board is dealt, its class is
+ * found with findIsoKey(), and the cached value must match the board's own
+ * value. The boards found for each class must add up to its weight, and
+ * calcClassWeight() must give that weight to exactly one of them and 0
+ * to the others. Running out of memory for the table is reported as a
+ * mismatch.
+ *
+ * @param result    verification result to fill, counting boards
+ */
+
+void verifyCanonicalBoards(VerifyResult *result) {
+    Card deck[DECK_SIZE] = {};
+    int deal = 0;
+
+    initializeDeck(deck);
+    result->checked = 0;
+    result->mismatch = FALSE;
+    for (deal = 0; deal < VERIFY_ISO_DEALS; deal++) {
+        IsoTable table = {};
+        HandValue *values = NULL;
+        long *found = NULL;
+        long *credited = NULL;
+        SuitSymmetry symmetry = {};
+        CardMask groups[2] = {};
+        CardMask canonical[2] = {};
+        int permutation[CARD_TYPE_AMOUNT] = {};
+        int unseen[DECK_SIZE] = {};
+        int indexes[BOARD_SIZE] = {};
+        int holeAmount = deal % (OMAHA_HOLE_SIZE + 1);
+        int boardAmount = FLOP_SIZE + (deal / (OMAHA_HOLE_SIZE + 1)) % 2;
+        int unseenAmount = 0;
+        int bit = 0;
+        long slot = 0;
+        long weight = 0;
+
+        shuffleDeck(deck);
+        groups[0] = cardsToMask(deck, holeAmount);
+        initializeSymmetry(&symmetry, groups, 1);
+        if (!enumerateCanonicalBoards(groups, 1, boardAmount, &table)) {
+            recordMismatch(result, deck, holeAmount, HIGH_CARD, HIGH_CARD);
+            return;
+        } // endif
+        values = malloc(table.capacity * sizeof(HandValue));
+        found = calloc(table.capacity, sizeof(long));
+        credited = calloc(table.capacity, sizeof(long));
+        if (values == NULL || found == NULL || credited == NULL) {
+            free(values);
+            free(found);
+            free(credited);
+            freeIsoTable(&table);
+            recordMismatch(result, deck, holeAmount, HIGH_CARD, HIGH_CARD);
+            return;
+        } // endif
+        for (slot = 0; slot < table.capacity; slot++) {
+            if (table.entries[slot].weight != 0) {
+                values[slot] = evaluateMask(table.entries[slot].groups[0] |
+                                            table.entries[slot].groups[1]);
+            } // endif
+        } // endfor
+
+        for (bit = 0; bit < DECK_SIZE; bit++) {
+            if (!(groups[0] & (1ULL << bit))) {
+                unseen[unseenAmount] = bit;
+                unseenAmount++;
+            } // endif
+        } // endfor
+        firstCombination(indexes, boardAmount);
+        do {
+            groups[1] = 0;
+            for (bit = 0; bit < boardAmount; bit++) {
+                groups[1] |= 1ULL << unseen[indexes[bit]];
+            } // endfor
+            canonicalizeGroups(groups, 2, canonical, permutation);
+            slot = findIsoKey(&table, canonical);
+            result->checked++;
+            if (slot == INVALID_INPUT ||
+                values[slot] != evaluateMask(groups[0] | groups[1])) {
+                result->mismatch = TRUE;
+                break;
+            } // endif
+            found[slot]++;
+            weight = calcClassWeight(&symmetry, groups[1]);
+            if (weight != 0) {
+                credited[slot] += (weight == table.entries[slot].weight) ?
+                                  weight : -1;
+            } // endif
+        } while (nextCombination(indexes, boardAmount, unseenAmount));
+        for (slot = 0; slot < table.capacity && !result->mismatch; slot++) {
+            result->mismatch = (found[slot] != table.entries[slot].weight ||
+                                credited[slot] != found[slot]);
+        } // endfor
+
+        free(values);
+        free(found);
+        free(credited);
+        freeIsoTable(&table);
+        if (result->mismatch) {
+            recordMismatch(result, deck, holeAmount, HIGH_CARD, HIGH_CARD);
+            return;
+        } // endif
+    } // endfor
+} // end function
+
+/**
+ * Function verifyValueEvaluator
+ * Runs verifyValues() for every hand size, displaying each outcome.
+ *
+ * @param evaluator   evaluator to verify
+ * @param reference   reference evaluator
+ * @param variant     deck variant to deal from
+ * @param name        name of the evaluator for display
+ * @param samples     amount of random hands per hand size
+ * @return            TRUE if no mismatch was found, FALSE otherwise
+ */
+
+static int verifyValueEvaluator(ValueEvaluator evaluator,
+                                ValueEvaluator reference,
+                                const DeckVariant *variant, wchar_t *name,
+                                long samples) {
+    VerifyResult result = {};
+    int cardAmount = 0;
+
+    wprintf(L"Verifying %ls\n", name);
+    for (cardAmount = POKER_HAND_SIZE; cardAmount <= MAX_EVAL_CARDS;
+         cardAmount++) {
+        wchar_t message[MAX_MESSAGE_LEN] = {};
+        swprintf(message, MAX_MESSAGE_LEN, L"  %d cards (sampled)",
+                 cardAmount);
+        verifyValues(evaluator, reference, variant, cardAmount, samples,
+                     &result);
+        displayVerifyResult(&result, message);
+        if (result.mismatch) {
+            return FALSE;
+        } // endif
+    } // endfor
+    return TRUE;
+} // end function
+
+/**
+ * Function displayVerifyResult
+ * Displays the outcome of a verification, including the first mismatching
+ * hand when there is one.
+ *
+ * @param result    verification result to display
+ * @param message   header string to print before display
+ */
+
+void displayVerifyResult(const VerifyResult *result, wchar_t *message) {
+    int cardIndex = 0;
+
+    wprintf(L"%ls: %ld hands checked", message, result->checked);
+    if (!result->mismatch) {
+        wprintf(L" - ok\n");
+        return;
+    } // endif
+    wprintf(L" - MISMATCH\nHand: ");
+    for (cardIndex = 0; cardIndex < result->cardAmount; cardIndex++) {
+        displayCard(result->cards[cardIndex]);
+    } // endfor
+    wprintf(L"\nExpected: %ls - Found: %ls\n",
+            POKER_RANK_STRING[result->expected],
+            POKER_RANK_STRING[result->found]);
+    if (result->expectedValue != result->foundValue) {
+        wprintf(L"Expected value: %#x - Found value: %#x\n",
+                result->expectedValue, result->foundValue);
+    } // endif
+} // end function
+
+/**
+ * Function verifyEvaluator
+ * Runs the exhaustive five card verification followed by sampled
+ * verifications for every larger hand size, displaying each outcome.
+ *
+ * @param evaluator   evaluator to verify
+ * @param name        name of the evaluator for display
+ * @param samples     amount of random hands per larger hand size
+ * @return            TRUE if no mismatch was found, FALSE otherwise
+ */
+
+int verifyEvaluator(ValueEvaluator evaluator, wchar_t *name, long samples) {
+    VerifyResult result = {};
+    int cardAmount = 0;
+
+    wprintf(L"Verifying %ls\n", name);
+    verifyExhaustive(evaluator, &result);
+    displayVerifyResult(&result, L"  5 cards (exhaustive)");
+    if (result.mismatch) {
+        return FALSE;
+    } // endif
+
+    for (cardAmount = POKER_HAND_SIZE + 1; cardAmount <= MAX_EVAL_CARDS;
+         cardAmount++) {
+        wchar_t message[MAX_MESSAGE_LEN] = {};
+        swprintf(message, MAX_MESSAGE_LEN, L"  %d cards (sampled)",
+                 cardAmount);
+        verifySampled(evaluator, cardAmount, samples, &result);
+        displayVerifyResult(&result, message);
+        if (result.mismatch) {
+            return FALSE;
+        } // endif
+    } // endfor
+    return TRUE;
+} // end function
+
+/**
+ * Function runVerification
+ * Verifies every optimized evaluator of the program against the reference
+ * cascade.
+ *
+ * @param samples   amount of random hands per larger hand size
+ * @return          NO_ERRORS if all evaluators agree, VERIFY_FAILED otherwise
+ */
+
+int runVerification(long samples) {
+    const DeckVariant *standard = findDeckVariant("standard");
+    int passed = TRUE;
+    VerifyResult result = {};
+
+    passed &= verifyEvaluator(evaluateCards, L"bitmask evaluator", samples);
+    passed &= verifyEvaluator(evaluateStreetCards, L"street state evaluator",
+                              samples);
+
+    wprintf(L"Verifying Omaha evaluator\n");
+    verifyOmaha(OMAHA_HOLE_SIZE, samples, &result);
+    displayVerifyResult(&result, L"  4 hole cards (sampled)");
+    passed &= !result.mismatch;
+    verifyOmaha(PLO5_HOLE_SIZE, samples, &result);
+    displayVerifyResult(&result, L"  5 hole cards (sampled)");
+    passed &= !result.mismatch;
+
+    wprintf(L"Verifying suit isomorphism\n");
+    verifyIsomorphism(samples, &result);
+    displayVerifyResult(&result, L"  hole and board (sampled)");
+    passed &= !result.mismatch;
+    verifyCanonicalBoards(&result);
+    displayVerifyResult(&result, L"  canonical boards (exhaustive)");
+    passed &= !result.mismatch;
+
+    wprintf(L"Verifying split pots\n");
+    verifySplitPot(samples, &result);
+    displayVerifyResult(&result, L"  high and low shares (sampled)");
+    passed &= !result.mismatch;
+
+    wprintf(L"Verifying evaluation cache\n");
+    verifyEvalCache(samples, &result);
+    displayVerifyResult(&result, L"  repeated hands (sampled)");
+    passed &= !result.mismatch;
+
+    wprintf(L"Verifying audit reports\n");
+    verifyAuditEcho(&result);
+    displayVerifyResult(&result, L"  escaped log bytes");
+    passed &= !result.mismatch;
+
+    passed &= verifyValueEvaluator(evaluateAceToFive, calcAceToFiveReference,
+                                   standard, L"ace to five low evaluator",
+                                   samples);
+    passed &= verifyValueEvaluator(evaluateEightOrBetter,
+                                   calcEightOrBetterReference, standard,
+                                   L"eight or better low evaluator", samples);
+    passed &= verifyValueEvaluator(evaluateDeuceToSeven,
+                                   calcDeuceToSevenReference, standard,
+                                   L"deuce to seven low evaluator", samples);
+    passed &= verifyValueEvaluator(evaluateShortDeckCards,
+                                   calcShortDeckReference,
+                                   findDeckVariant("short"),
+                                   L"short deck evaluator", samples);
+    passed &= verifyValueEvaluator(evaluateJokerCards, calcJokerReference,
+                                   findDeckVariant("joker"),
+                                   L"joker evaluator", samples);
+    passed &= verifyValueEvaluator(evaluateDeucesWildCards,
+                                   calcDeucesWildReference,
+                                   findDeckVariant("deuces"),
+                                   L"deuces wild evaluator", samples);
+    return passed ? NO_ERRORS : VERIFY_FAILED;
+} // end function